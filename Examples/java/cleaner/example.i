@@ -0,0 +1,17 @@
+/* File : example.i */
+%module example
+
+%inline %{
+/* A small value type, typical of the objects created and discarded in large
+   numbers by Java code */
+class Point {
+public:
+  static int live;
+  double x, y;
+  Point(double x, double y) : x(x), y(y) { live++; }
+  ~Point() { live--; }
+  Point translate(double dx, double dy) const { return Point(x + dx, y + dy); }
+};
+
+int Point::live = 0;
+%}
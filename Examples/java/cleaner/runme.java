@@ -0,0 +1,56 @@
+// This example measures the cost of garbage collecting proxy classes which own
+// a C++ object.  The same class is wrapped with finalizable proxies (the
+// default) and with proxies registered with a java.lang.ref.Cleaner
+// (-DSWIG_JAVA_USE_CLEANER).  Java 9 or later is required.
+
+public class runme {
+  static {
+    try {
+        System.loadLibrary("finalizer");
+        System.loadLibrary("cleaner");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  static final int COUNT = 2000000;
+
+  static double finalizerProxies() {
+    finalizer.Point p = new finalizer.Point(0, 0);
+    for (int i = 0; i < COUNT; i++)
+      p = p.translate(1, 1);
+    return p.getX();
+  }
+
+  static double cleanerProxies() {
+    cleaner.Point p = new cleaner.Point(0, 0);
+    for (int i = 0; i < COUNT; i++)
+      p = p.translate(1, 1);
+    return p.getX();
+  }
+
+  static void waitForCollection(String name, java.util.function.IntSupplier live) throws InterruptedException {
+    for (int i = 0; i < 100 && live.getAsInt() > 1; i++) {
+      System.gc();
+      Thread.sleep(10);
+    }
+    System.out.println("    " + name + " C++ objects still alive: " + live.getAsInt());
+  }
+
+  public static void main(String argv[]) throws InterruptedException {
+    for (int run = 0; run < 3; run++) {
+      System.out.println("Run " + run + ", creating " + COUNT + " proxies owning a C++ object:");
+
+      long start = System.nanoTime();
+      finalizerProxies();
+      System.out.println("    finalize(): " + (System.nanoTime() - start) / 1000000 + " ms");
+      waitForCollection("finalize()", () -> finalizer.Point.getLive());
+
+      start = System.nanoTime();
+      cleanerProxies();
+      System.out.println("    Cleaner:    " + (System.nanoTime() - start) / 1000000 + " ms");
+      waitForCollection("Cleaner", () -> cleaner.Point.getLive());
+    }
+  }
+}
@@ -0,0 +1,22 @@
+%module(directors="1", dirprot="1") Simple
+
+%feature("director") MyClass;
+
+%inline %{
+class MyClass {
+public:
+    MyClass () {}
+    virtual ~MyClass () {}
+    virtual void func () {}
+    void call_func (int n) {
+        for (int i = 0; i < n; ++i)
+            func();
+    }
+    void call_prot (int n) {
+        for (int i = 0; i < n; ++i)
+            prot();
+    }
+protected:
+    virtual void prot () {}
+};
+%}
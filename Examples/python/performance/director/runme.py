@@ -0,0 +1,16 @@
+#!/usr/bin/env
+
+import sys
+sys.path.append('..')
+import harness
+
+def proc (mod) :
+    class Inherited(mod.MyClass) :
+        def prot (self) :
+            mod.MyClass.prot(self)
+
+    x = Inherited()
+    x.call_func(10000000)
+    x.call_prot(1000000)
+
+harness.run(proc)
@@ -0,0 +1,10 @@
+%inline %{
+class MyClass {
+public:
+    MyClass () : value(0) {}
+    ~MyClass () {}
+    int value;
+    int get () const { return value; }
+    void set (int v) { value = v; }
+};
+%}
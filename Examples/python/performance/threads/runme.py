@@ -0,0 +1,21 @@
+#!/usr/bin/env
+
+import sys
+import threading
+sys.path.append('..')
+import harness
+
+def getters (mod) :
+    x = mod.MyClass()
+    for i in range(1000000) :
+        x.value = x.get()
+        x.set(x.value)
+
+def proc (mod) :
+    threads = [threading.Thread(target=getters, args=(mod,)) for i in range(4)]
+    for t in threads :
+        t.start()
+    for t in threads :
+        t.join()
+
+harness.run(proc)
@@ -532,6 +532,7 @@ C_TEST_CASES += \
 	preproc_defined \
 	preproc_include \
 	preproc_line_file \
+	preproc_redefine \
 	ret_by_value \
 	simple_array \
 	sizeof_pointer \
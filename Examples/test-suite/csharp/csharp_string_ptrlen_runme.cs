@@ -0,0 +1,41 @@
+using System;
+using csharp_string_ptrlenNamespace;
+
+public class csharp_string_ptrlen_runme {
+
+  public static void Main() {
+    Assert(csharp_string_ptrlen.cstr_echo("hello"), "hello");
+    Assert(csharp_string_ptrlen.cstr_echo(""), "");
+    Assert(csharp_string_ptrlen.cstr_echo(null), null);
+    Assert(csharp_string_ptrlen.cstr_null(), null);
+
+    Assert(csharp_string_ptrlen.string_echo("hello"), "hello");
+    Assert(csharp_string_ptrlen.string_echo(""), "");
+    Assert(csharp_string_ptrlen.string_nul(), "a\0b");
+    Assert(csharp_string_ptrlen.string_ref(), "reference");
+
+    Callback cb = new Callback();
+    Assert(csharp_string_ptrlen.call_run(cb, "a", "b"), "ab");
+    Assert(csharp_string_ptrlen.call_run(cb, "a", null), "a(null)");
+
+    Callback reverse = new ReverseCallback();
+    Assert(csharp_string_ptrlen.call_run(reverse, "a", "b"), "ba");
+    Assert(csharp_string_ptrlen.call_run(reverse, "a", null), "null:a");
+    csharp_string_ptrlen.call_run_nul(reverse);
+    Assert(ReverseCallback.last, "x\0y");
+  }
+
+  static void Assert(string actual, string expected) {
+    if (actual != expected)
+      throw new Exception("Expected " + (expected == null ? "null" : "'" + expected + "'") + " got " + (actual == null ? "null" : "'" + actual + "'"));
+  }
+}
+
+public class ReverseCallback : Callback {
+  public static string last;
+
+  public override string run(string s, string c) {
+    last = s;
+    return c == null ? "null:" + s : c + s;
+  }
+}
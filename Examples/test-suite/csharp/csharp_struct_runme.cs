@@ -0,0 +1,54 @@
+using System;
+using csharp_structNamespace;
+
+public class csharp_struct_runme {
+
+  public static void Main() {
+    Vec3 a = csharp_struct.make(1, 2, 3);
+    Vec3 v = csharp_struct.add(a, a);
+    Assert(v.x, 2.0);
+    Assert(v.y, 4.0);
+    Assert(v.z, 6.0);
+
+    csharp_struct.scale(ref v, 0.5);
+    Assert(v.x, 1.0);
+    Assert(v.z, 3.0);
+    csharp_struct.increment(ref v);
+    Assert(v.x, 2.0);
+
+    Segment s = new Segment();
+    s.a = a;
+    s.b = v;
+    s.id = 10;
+    Assert(csharp_struct.length(s), 1.0);
+
+    Assert(csharp_struct.null_vec().x, 0.0);
+    Assert(csharp_struct.unit_z().z, 1.0);
+
+    Assert(csharp_struct.global_vec.y, 5.0);
+    csharp_struct.global_vec = a;
+    Assert(csharp_struct.global_vec.y, 2.0);
+
+    Body body = new Body();
+    body.position = v;
+    Assert(body.position.x, 2.0);
+
+    Assert(csharp_struct.accept(new Visitor()).x, 7.0);
+    Assert(csharp_struct.accept(new DoublingVisitor()).x, 14.0);
+
+    if (!typeof(Vec3).IsValueType)
+      throw new Exception("Vec3 is not a C# struct");
+  }
+
+  private static void Assert(double d1, double d2) {
+    if (d1 != d2)
+      throw new Exception("assertion failure. " + d1 + " != " + d2);
+  }
+}
+
+public class DoublingVisitor : Visitor {
+  public override Vec3 visit(Vec3 v) {
+    v.x *= 2;
+    return v;
+  }
+}
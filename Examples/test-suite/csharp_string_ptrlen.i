@@ -0,0 +1,28 @@
+%module(directors="1") csharp_string_ptrlen
+
+// Strings returned as a pointer and length, tested with SWIG_CSHARP_STRING_PTRLEN defined
+
+%include <std_string.i>
+
+%feature("director") Callback;
+
+%inline %{
+#include <string>
+
+const char *cstr_echo(const char *s) { return s; }
+const char *cstr_null() { return 0; }
+std::string string_echo(const std::string &s) { return s; }
+std::string string_nul() { return std::string("a\0b", 3); }
+const std::string &string_ref() {
+  static const std::string s("reference");
+  return s;
+}
+
+struct Callback {
+  virtual ~Callback() {}
+  virtual std::string run(const std::string &s, const char *c) { return s + (c ? c : "(null)"); }
+};
+
+std::string call_run(Callback *cb, const std::string &s, const char *c) { return cb->run(s, c); }
+std::string call_run_nul(Callback *cb) { return cb->run(std::string("x\0y", 3), 0); }
+%}
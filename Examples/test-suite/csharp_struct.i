@@ -0,0 +1,43 @@
+%module(directors="1") csharp_struct
+
+// Plain old data classes wrapped as blittable C# structs with %csstruct
+%csstruct(Vec3)
+%csstruct(Segment)
+
+%warnfilter(SWIGWARN_CSHARP_STRUCT_MEMBER_IGNORED) Segment::midpoint;
+
+%feature("director") Visitor;
+
+%inline %{
+struct Vec3 {
+  double x, y, z;
+};
+
+struct Segment {
+  Vec3 a;
+  Vec3 b;
+  int id;
+  Vec3 midpoint() const { Vec3 m = { (a.x + b.x)/2, (a.y + b.y)/2, (a.z + b.z)/2 }; return m; }
+};
+
+Vec3 make(double x, double y, double z) { Vec3 v = { x, y, z }; return v; }
+Vec3 add(Vec3 a, const Vec3 &b) { return make(a.x + b.x, a.y + b.y, a.z + b.z); }
+void scale(Vec3 &v, double f) { v.x *= f; v.y *= f; v.z *= f; }
+void increment(Vec3 *v) { v->x += 1; }
+double length(const Segment &s) { return s.b.x - s.a.x; }
+Vec3 *null_vec() { return 0; }
+const Vec3 &unit_z() { static Vec3 z = { 0, 0, 1 }; return z; }
+
+Vec3 global_vec = { 4, 5, 6 };
+
+struct Body {
+  Vec3 position;
+  int id;
+};
+
+struct Visitor {
+  virtual ~Visitor() {}
+  virtual Vec3 visit(Vec3 v) { return v; }
+};
+Vec3 accept(Visitor *visitor) { return visitor->visit(make(7, 8, 9)); }
+%}
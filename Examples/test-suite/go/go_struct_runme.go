@@ -0,0 +1,61 @@
+package main
+
+import "./go_struct"
+
+func main() {
+	c := go_struct.Blend(go_struct.Color{R: 10, G: 20, B: 30, A: 40}, go_struct.Color{R: 30, G: 40, B: 50, A: 60})
+	if c.R != 20 || c.G != 30 || c.B != 40 || c.A != 50 {
+		panic(c)
+	}
+
+	go_struct.Invert(&c)
+	if c.R != 235 || c.B != 215 || c.A != 50 {
+		panic(c)
+	}
+
+	go_struct.Brighten(&c, 5)
+	if c.R != 240 || c.G != 230 {
+		panic(c)
+	}
+
+	if k := go_struct.Black(); k.R != 0 || k.A != 255 {
+		panic(k)
+	}
+
+	s := go_struct.Make_sample(1000, 2.5, 7)
+	if s.Time != 1000 || s.Value != 2.5 || s.Channel != 7 || s.Color.A != 4 {
+		panic(s)
+	}
+	s.Color.A = 3
+	if go_struct.Sample_time(s) != 1010 {
+		panic(s)
+	}
+
+	p := go_struct.NewPixel()
+	p.SetColor(c)
+	if p.GetColor().G != 230 {
+		panic(p.GetColor())
+	}
+	go_struct.DeletePixel(p)
+
+	dv := go_struct.NewDoubleVector()
+	dv.FromSlice([]float64{1.5, 2.5, 3})
+	if dv.Size() != 3 || dv.Get(1) != 2.5 || go_struct.Sum(dv) != 7 {
+		panic(dv.Size())
+	}
+	ds := dv.ToSlice()
+	if len(ds) != 3 || ds[0] != 1.5 || ds[2] != 3 {
+		panic(ds)
+	}
+
+	iv := go_struct.NewIntVector()
+	if len(iv.ToSlice()) != 0 {
+		panic(0)
+	}
+	iv.FromSlice([]int32{4, 5})
+	iv.Add(6)
+	is := iv.ToSlice()
+	if len(is) != 3 || is[0] != 4 || is[2] != 6 {
+		panic(is)
+	}
+}
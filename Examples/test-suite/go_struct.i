@@ -0,0 +1,54 @@
+%module go_struct
+
+// Plain old data classes wrapped as Go structs with %gostruct and bulk
+// std::vector to Go slice conversion
+%include <std_vector.i>
+
+%gostruct(Color)
+%gostruct(Sample)
+
+%warnfilter(SWIGWARN_GO_STRUCT_MEMBER_IGNORED) Color::luma;
+
+%template(DoubleVector) std::vector<double>;
+%template(IntVector) std::vector<int>;
+
+%inline %{
+struct Color {
+  unsigned char r, g, b, a;
+  int luma() const { return (r + g + b) / 3; }
+};
+
+// Mixed member sizes, so the Go struct needs the same padding as C++
+struct Sample {
+  long long time;
+  float value;
+  short channel;
+  Color color;
+};
+
+Color blend(Color x, const Color &y) {
+  Color c = { (unsigned char)((x.r + y.r) / 2), (unsigned char)((x.g + y.g) / 2), (unsigned char)((x.b + y.b) / 2), (unsigned char)((x.a + y.a) / 2) };
+  return c;
+}
+void invert(Color &c) { c.r = 255 - c.r; c.g = 255 - c.g; c.b = 255 - c.b; }
+void brighten(Color *c, unsigned char d) { c->r += d; c->g += d; c->b += d; }
+const Color &black() { static Color k = { 0, 0, 0, 255 }; return k; }
+
+Sample make_sample(long long time, float value, short channel) {
+  Sample s = { time, value, channel, { 1, 2, 3, 4 } };
+  return s;
+}
+long long sample_time(const Sample &s) { return s.time + s.channel + s.color.a; }
+
+struct Pixel {
+  Color color;
+  int x, y;
+};
+
+double sum(const std::vector<double> &v) {
+  double s = 0;
+  for (size_t i = 0; i < v.size(); i++)
+    s += v[i];
+  return s;
+}
+%}
@@ -0,0 +1,24 @@
+%module preproc_redefine
+
+%warnfilter(SWIGWARN_PARSE_REDEFINED) VALUE;
+
+// Check a macro which is redefined after it has been used expands to its new definition
+
+#define VALUE 1
+%constant int value1 = VALUE;
+#undef VALUE
+#define VALUE 2
+%constant int value2 = VALUE;
+
+#define ADD(x) (x + 10)
+%constant int add1 = ADD(1);
+#undef ADD
+#define ADD(x) (x + 20)
+%constant int add2 = ADD(1);
+
+// A macro whose expansion uses a redefined macro
+#define INDIRECT VALUE
+%constant int indirect1 = INDIRECT;
+#undef VALUE
+#define VALUE 3
+%constant int indirect2 = INDIRECT;
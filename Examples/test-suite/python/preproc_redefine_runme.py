@@ -0,0 +1,16 @@
+import preproc_redefine
+
+if preproc_redefine.value1 != 1:
+  raise RuntimeError
+if preproc_redefine.value2 != 2:
+  raise RuntimeError
+
+if preproc_redefine.add1 != 11:
+  raise RuntimeError
+if preproc_redefine.add2 != 21:
+  raise RuntimeError
+
+if preproc_redefine.indirect1 != 2:
+  raise RuntimeError
+if preproc_redefine.indirect2 != 3:
+  raise RuntimeError
@@ -0,0 +1,56 @@
+from python_director_override import *
+
+class Derived(Base):
+  pass
+
+class Assigned(Base):
+  def __init__(self):
+    Base.__init__(self)
+    self.func = lambda x: x * 4
+
+class Intercepted(Base):
+  def __getattribute__(self, name):
+    if name == "func":
+      return lambda x: x + 50
+    return Base.__getattribute__(self, name)
+
+# Method added to the Python class after construction
+d = Derived()
+if d.call_func(1) != 2:
+  raise RuntimeError
+Derived.func = lambda self, x: x + 1000
+if d.call_func(1) != 1001:
+  raise RuntimeError
+del Derived.func
+if d.call_func(1) != 2:
+  raise RuntimeError
+
+# Method assigned to the object
+a = Assigned()
+if a.call_func(2) != 8:
+  raise RuntimeError
+d.func = lambda x: x + 100
+if d.call_func(1) != 101:
+  raise RuntimeError
+del d.func
+if d.call_func(1) != 2:
+  raise RuntimeError
+
+# Attribute lookup customised by the Python class
+i = Intercepted()
+if i.call_func(1) != 51:
+  raise RuntimeError
+
+# Proxy class patched after construction, not possible with -builtin
+# Restore the method from the class dictionary, with -O it is not a plain function
+try:
+  original = Base.__dict__['func']
+  Base.func = lambda self, x: x + 10
+except TypeError:
+  original = None
+if original is not None:
+  if d.call_func(1) != 11:
+    raise RuntimeError
+  Base.func = original
+  if d.call_func(1) != 2:
+    raise RuntimeError
@@ -0,0 +1,24 @@
+import python_nogil
+
+if python_nogil.held_with_gil() == -1:
+  pass # GIL state not available from this Python version
+else:
+  if python_nogil.held_with_gil() != 1:
+    raise RuntimeError("%gil function released the GIL")
+
+  # Constructors release the GIL
+  r = python_nogil.Recorder()
+  if r.held != 0:
+    raise RuntimeError("constructor kept the GIL")
+
+  # Member variable accessors keep it
+  p = python_nogil.Probe()
+  p.recorder = r
+  if p.recorder.held != 1:
+    raise RuntimeError("member variable setter released the GIL")
+
+  # Code making calls releases it
+  if python_nogil.held_in_call() != 0:
+    raise RuntimeError("function making a call kept the GIL")
+  if p.held_in_extend() != 0:
+    raise RuntimeError("%extend method making a call kept the GIL")
@@ -0,0 +1,13 @@
+%module(directors="1") python_director_override
+
+// Check the C++ method is only called directly while the Python object does not override it
+
+%feature("director") Base;
+
+%inline %{
+struct Base {
+  virtual ~Base() {}
+  virtual int func(int x) { return x + 1; }
+  int call_func(int x) { return func(x); }
+};
+%}
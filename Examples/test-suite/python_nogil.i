@@ -0,0 +1,38 @@
+%module python_nogil
+
+// Built with -threads.  Check which wrappers release the GIL with %autogil:
+// member variable accessors keep it, constructors and code making calls release it
+
+%{
+/* Whether the calling thread holds the GIL, or -1 if it cannot be told */
+static int gil_held() {
+#if PY_VERSION_HEX >= 0x03040000
+  return PyGILState_Check();
+#else
+  return -1;
+#endif
+}
+%}
+
+%autogil;
+%gil held_with_gil;
+%ignore Recorder::operator=;
+
+%inline %{
+struct Recorder {
+  int held;
+  Recorder() : held(gil_held()) {}
+  Recorder &operator=(const Recorder &) { held = gil_held(); return *this; }
+};
+
+struct Probe {
+  Recorder recorder;
+};
+
+int held_in_call() { return gil_held(); }
+int held_with_gil() { return gil_held(); }
+%}
+
+%extend Probe {
+  int held_in_extend() { return gil_held(); }
+}
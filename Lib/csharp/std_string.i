@@ -107,5 +107,26 @@ class string;
 %{ SWIG_CSharpSetPendingException(SWIG_CSharpApplicationException, $1.c_str());
    return $null; %}
 
+#if defined(SWIG_CSHARP_STRING_PTRLEN)
+// returned as a copy of the string, freed by C# once decoded
+%typemap(ctype, out="SWIG_CSharpString") string, const string & "char *"
+%typemap(imtype, out="$module.SWIGStringPtrLen", directorout="string") string, const string & "string"
+
+%typemap(out, null="SWIG_csharp_string_null") string %{ $result = SWIG_csharp_string_copy($1.data(), $1.size()); %}
+%typemap(out, null="SWIG_csharp_string_null") const string & %{ $result = SWIG_csharp_string_copy($1->data(), $1->size()); %}
+%typemap(directorin) string, const string & %{ $input = SWIG_csharp_string_ref($1.data(), $1.size()); %}
+%typemap(csdirectorin) string, const string & "$imclassname.SWIGStringFromPtrLen($iminput)"
+
+%typemap(csout, excode=SWIGEXCODE) string, const string & {
+    string ret = $imclassname.SWIGStringFromPtrLen($imcall);$excode
+    return ret;
+  }
+%typemap(csvarout, excode=SWIGEXCODE2) const string & %{
+    get {
+      string ret = $imclassname.SWIGStringFromPtrLen($imcall);$excode
+      return ret;
+    } %}
+#endif
+
 }
 
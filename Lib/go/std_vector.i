@@ -76,3 +76,85 @@ namespace std {
         }
     };
 }
+
+/* Bulk conversion between vectors of arithmetic types and Go slices.
+   ToSlice returns a copy of the whole vector as a new Go slice and
+   FromSlice replaces the contents of the vector with a copy of a Go
+   slice, each in a single call rather than one call per element.  The
+   Go element types have the same size as the C++ element types so
+   that the elements are copied with memcpy.  */
+
+%{
+typedef _goslice_ swiggo_slice_byte;
+typedef _goslice_ swiggo_slice_int8;
+typedef _goslice_ swiggo_slice_uint8;
+typedef _goslice_ swiggo_slice_int16;
+typedef _goslice_ swiggo_slice_uint16;
+typedef _goslice_ swiggo_slice_int32;
+typedef _goslice_ swiggo_slice_uint32;
+typedef _goslice_ swiggo_slice_int64;
+typedef _goslice_ swiggo_slice_uint64;
+typedef _goslice_ swiggo_slice_float32;
+typedef _goslice_ swiggo_slice_float64;
+%}
+
+%define %std_vector_go_slice_type(GOTYPE)
+typedef _goslice_ swiggo_slice_##GOTYPE;
+
+%typemap(gotype) swiggo_slice_##GOTYPE %{[]GOTYPE%}
+
+%typemap(in) swiggo_slice_##GOTYPE
+%{ $1 = $input; %}
+
+%typemap(out) swiggo_slice_##GOTYPE
+%{ $result = $1; %}
+%enddef
+
+%define %std_vector_go_slice(CTYPE, GOTYPE)
+%extend std::vector<CTYPE> {
+    swiggo_slice_##GOTYPE ToSlice() {
+        swiggo_slice_##GOTYPE s;
+        size_t n = self->size();
+        s.array = _swig_goallocate(n * sizeof(CTYPE));
+        if (n > 0)
+            memcpy(s.array, &(*self)[0], n * sizeof(CTYPE));
+        s.len = s.cap = (unsigned int)n;
+        return s;
+    }
+    void FromSlice(swiggo_slice_##GOTYPE s) {
+        const CTYPE *p = (const CTYPE *)s.array;
+        self->assign(p, p + s.len);
+    }
+}
+%enddef
+
+%std_vector_go_slice_type(byte)
+%std_vector_go_slice_type(int8)
+%std_vector_go_slice_type(uint8)
+%std_vector_go_slice_type(int16)
+%std_vector_go_slice_type(uint16)
+%std_vector_go_slice_type(int32)
+%std_vector_go_slice_type(uint32)
+%std_vector_go_slice_type(int64)
+%std_vector_go_slice_type(uint64)
+%std_vector_go_slice_type(float32)
+%std_vector_go_slice_type(float64)
+
+%std_vector_go_slice(char, byte)
+%std_vector_go_slice(signed char, int8)
+%std_vector_go_slice(unsigned char, uint8)
+%std_vector_go_slice(short, int16)
+%std_vector_go_slice(unsigned short, uint16)
+%std_vector_go_slice(int, int32)
+%std_vector_go_slice(unsigned int, uint32)
+#if SWIGGO_LONG_TYPE_SIZE == 32
+%std_vector_go_slice(long, int32)
+%std_vector_go_slice(unsigned long, uint32)
+#else
+%std_vector_go_slice(long, int64)
+%std_vector_go_slice(unsigned long, uint64)
+#endif
+%std_vector_go_slice(long long, int64)
+%std_vector_go_slice(unsigned long long, uint64)
+%std_vector_go_slice(float, float32)
+%std_vector_go_slice(double, float64)
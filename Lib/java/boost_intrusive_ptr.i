@@ -292,6 +292,14 @@
   }
 %}
 
+// Smart pointer proxies are always finalizable, including with SWIG_JAVA_USE_CLEANER
+%typemap(javafinalize) TYPE %{
+  protected void finalize() {
+    delete();
+  }
+%}
+%typemap(javadeleter) TYPE ""
+
 %typemap(javadestruct, methodname="delete", methodmodifiers="public synchronized") TYPE {
     if(swigCPtr != 0 && swigCMemOwnBase) {
       swigCMemOwnBase = false;
@@ -442,6 +450,14 @@
   }
 %}
 
+// Smart pointer proxies are always finalizable, including with SWIG_JAVA_USE_CLEANER
+%typemap(javafinalize) TYPE %{
+  protected void finalize() {
+    delete();
+  }
+%}
+%typemap(javadeleter) TYPE ""
+
 %typemap(javadestruct, methodname="delete", methodmodifiers="public synchronized") TYPE {
     if (swigCPtr != 0) {
       if (swigCMemOwnBase) {
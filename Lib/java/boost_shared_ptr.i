@@ -174,6 +174,14 @@
   }
 %}
 
+// Smart pointer proxies are always finalizable, including with SWIG_JAVA_USE_CLEANER
+%typemap(javafinalize) TYPE %{
+  protected void finalize() {
+    delete();
+  }
+%}
+%typemap(javadeleter) TYPE ""
+
 %typemap(javadestruct, methodname="delete", methodmodifiers="public synchronized") TYPE {
     if (swigCPtr != 0) {
       if (swigCMemOwnBase) {
@@ -217,6 +217,196 @@ static int cparse_template_expand(Node *n, String *tname, String *rname, String
   return 0;
 }
 
+/* -----------------------------------------------------------------------------
+ * Template instantiation plan
+ *
+ * Instantiating a template patches every string collected by
+ * cparse_template_expand() once for each template parameter, yet most of the
+ * strings in a template body are not changed by any of the patches.  The plan
+ * records, for the strings collected from a template, which template parameters
+ * (and for types, the template name) patching actually changes each string for,
+ * so that further instantiations only patch the strings that need it.
+ *
+ * The plan belongs to the template node found by Swig_cparse_template_locate()
+ * and is kept in a side table keyed by the address of that node, so that it does
+ * not show up in the parse tree.  The parser copies the located node and expands
+ * the copy straight away, so the expansion uses the plan of the template that was
+ * located last.  A string is only trusted to have the
+ * recorded parameters if it is the same as the string it was recorded for,
+ * otherwise it is checked again.  Once a replacement mentions a parameter name
+ * or the template name, the remaining patches are applied to every string.
+ * ----------------------------------------------------------------------------- */
+
+#define TEMPLATE_PLAN_MAXPARMS 31
+#define TEMPLATE_PLAN_TNAME (1U << TEMPLATE_PLAN_MAXPARMS)
+
+typedef struct {
+  List *names;			/* template parameter names, "" if unnamed */
+  String *tbase;		/* template name without any scope */
+  List *strings[3];		/* strings in the patchlist, typelist and cpatchlist */
+  unsigned int *uses[3];	/* parameters used by each string, TEMPLATE_PLAN_TNAME for tbase */
+} TemplatePlan;
+
+static void template_plan_clear(TemplatePlan *plan) {
+  int k;
+  Delete(plan->names);
+  Delete(plan->tbase);
+  plan->names = 0;
+  plan->tbase = 0;
+  for (k = 0; k < 3; k++) {
+    Delete(plan->strings[k]);
+    free(plan->uses[k]);
+    plan->strings[k] = 0;
+    plan->uses[k] = 0;
+  }
+}
+
+static void template_plan_delete(void *ptr) {
+  template_plan_clear((TemplatePlan *) ptr);
+  free(ptr);
+}
+
+static Hash *template_plans = 0;	/* template node address -> plan */
+static TemplatePlan *template_plan_located = 0;	/* plan for the next expansion */
+
+/* Makes the plan of a template node, created when first needed, the one for the next expansion */
+static void template_plan_locate(Node *n) {
+  String *key = NewStringf("%p", n);
+  DOH *v;
+  if (!template_plans)
+    template_plans = NewHash();
+  v = Getattr(template_plans, key);
+  if (!v) {
+    TemplatePlan *plan = (TemplatePlan *) malloc(sizeof(TemplatePlan));
+    int k;
+    plan->names = 0;
+    plan->tbase = 0;
+    for (k = 0; k < 3; k++) {
+      plan->strings[k] = 0;
+      plan->uses[k] = 0;
+    }
+    v = NewVoid(plan, template_plan_delete);
+    Setattr(template_plans, key, v);
+    Delete(v);
+  }
+  template_plan_located = (TemplatePlan *) Data(v);
+  Delete(key);
+}
+
+/* Checks if s contains any of the template parameter names or the template name */
+static int template_plan_mentions(String *s, List *names, String *tbase) {
+  int i;
+  int len = Len(names);
+  for (i = 0; i < len; i++) {
+    String *name = Getitem(names, i);
+    if (Len(name) && Strstr(s, name))
+      return 1;
+  }
+  return Strstr(s, tbase) != 0;
+}
+
+/* Checks if patching s in the given list (0 patchlist, 1 typelist, 2 cpatchlist) changes it */
+static int template_plan_patches(String *s, int which, String *name) {
+  String *t;
+  String *hash;
+  int changed;
+  if (!Strstr(s, name))
+    return 0;
+  t = Copy(s);
+  if (which == 0) {
+    Replace(t, name, "$tparm", DOH_REPLACE_ID);
+  } else if (which == 1) {
+    SwigType_typename_replace(t, name, "$tparm");
+  } else {
+    hash = NewStringf("#%s", name);
+    Replace(t, hash, "\"$tparm\"", DOH_REPLACE_ID);
+    Replace(t, name, "$tparm", DOH_REPLACE_ID);
+    Delete(hash);
+  }
+  changed = !Equal(s, t);
+  Delete(t);
+  return changed;
+}
+
+/* Returns the template parameters, and for the typelist the template name, that patching changes s for */
+static unsigned int template_plan_find(String *s, int which, List *names, String *tbase) {
+  unsigned int used = 0;
+  int i;
+  int len = Len(names);
+  for (i = 0; i < len; i++) {
+    String *name = Getitem(names, i);
+    if (Len(name) && template_plan_patches(s, which, name))
+      used |= 1U << i;
+  }
+  if (which == 1 && template_plan_patches(s, which, tbase))
+    used |= TEMPLATE_PLAN_TNAME;
+  return used;
+}
+
+/* Returns the parameters used by each of the strings in lists, updating the plan */
+static void template_plan_uses(TemplatePlan *plan, List *names, String *tbase, List *lists[3], unsigned int *uses[3]) {
+  int k;
+  int valid = plan->names && Equal(plan->tbase, tbase) && Len(plan->names) == Len(names);
+  int i;
+  for (i = 0; valid && i < Len(names); i++) {
+    if (!Equal(Getitem(names, i), Getitem(plan->names, i)))
+      valid = 0;
+  }
+  if (!valid) {
+    template_plan_clear(plan);
+    plan->names = Copy(names);
+    plan->tbase = Copy(tbase);
+  }
+
+  for (k = 0; k < 3; k++) {
+    int len = Len(lists[k]);
+    uses[k] = (unsigned int *) malloc(sizeof(unsigned int) * (len + 1));
+    if (!plan->strings[k] || Len(plan->strings[k]) != len) {
+      /* Different template body, record this instantiation's strings for the next one */
+      Delete(plan->strings[k]);
+      free(plan->uses[k]);
+      plan->strings[k] = NewList();
+      plan->uses[k] = (unsigned int *) malloc(sizeof(unsigned int) * (len + 1));
+      for (i = 0; i < len; i++) {
+	String *s = Copy(Getitem(lists[k], i));
+	Append(plan->strings[k], s);
+	plan->uses[k][i] = template_plan_find(s, k, names, tbase);
+	Delete(s);
+      }
+    } else {
+      for (i = 0; i < len; i++) {
+	String *s = Getitem(lists[k], i);
+	if (!Equal(s, Getitem(plan->strings[k], i))) {
+	  String *c = Copy(s);
+	  Setitem(plan->strings[k], i, c);
+	  plan->uses[k][i] = template_plan_find(s, k, names, tbase);
+	  Delete(c);
+	}
+      }
+    }
+    memcpy(uses[k], plan->uses[k], sizeof(unsigned int) * len);
+  }
+}
+
+/* Returns the template parameter names in templateparms, or 0 if there are too many for a plan */
+static List *template_plan_names(Parm *tp) {
+  List *names;
+  if (ParmList_len(tp) > TEMPLATE_PLAN_MAXPARMS)
+    return 0;
+  names = NewList();
+  for (; tp; tp = nextSibling(tp)) {
+    String *name = Getattr(tp, "name");
+    if (name) {
+      Append(names, name);
+    } else {
+      String *empty = NewStringEmpty();
+      Append(names, empty);
+      Delete(empty);
+    }
+  }
+  return names;
+}
+
 static
 String *partial_arg(String *s, String *p) {
   char *c;
@@ -242,6 +432,7 @@ String *partial_arg(String *s, String *p) {
  * ----------------------------------------------------------------------------- */
 
 int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab *tscope) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_TEMPLATE_EXPAND);
   List *patchlist, *cpatchlist, *typelist;
   String *templateargs;
   String *tname;
@@ -318,11 +509,22 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 
     if (tp) {
       Symtab *tsdecl = Getattr(n, "sym:symtab");
+      TemplatePlan *plan = template_plan_located;
+      List *names = plan ? template_plan_names(tp) : 0;
+      List *lists[3];
+      unsigned int *uses[3] = { 0, 0, 0 };
+      int k = 0;
+      lists[0] = patchlist;
+      lists[1] = typelist;
+      lists[2] = cpatchlist;
+      if (names)
+	template_plan_uses(plan, names, tbase, lists, uses);
       while (p && tp) {
 	String *name, *value, *valuestr, *tydef, *tmp, *tmpr;
 	int sz, i;
 	String *dvalue = 0;
 	String *qvalue = 0;
+	unsigned int bit = 1U << k;
 
 	name = Getattr(tp, "name");
 	value = Getattr(p, "value");
@@ -341,6 +543,13 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 
 	  assert(dvalue);
 	  valuestr = SwigType_str(dvalue, 0);
+	  if (uses[0] && (template_plan_mentions(dvalue, names, tbase) || template_plan_mentions(valuestr, names, tbase))) {
+	    /* The replacements may introduce names the plan does not know about, so patch every string from here on */
+	    for (i = 0; i < 3; i++) {
+	      free(uses[i]);
+	      uses[i] = 0;
+	    }
+	  }
 	  /* Need to patch default arguments */
 	  {
 	    Parm *rp = nextSibling(p);
@@ -355,11 +564,15 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 	  sz = Len(patchlist);
 	  for (i = 0; i < sz; i++) {
 	    String *s = Getitem(patchlist, i);
+	    if (uses[0] && !(uses[0][i] & bit))
+	      continue;
 	    Replace(s, name, dvalue, DOH_REPLACE_ID);
 	  }
 	  sz = Len(typelist);
 	  for (i = 0; i < sz; i++) {
 	    String *s = Getitem(typelist, i);
+	    if (uses[1] && !(uses[1][i] & (bit | TEMPLATE_PLAN_TNAME)))
+	      continue;
 	    /*      Replace(s,name,value, DOH_REPLACE_ID); */
 	    /*      Printf(stdout,"name = '%s', value = '%s', tbase = '%s', iname='%s' s = '%s' --> ", name, dvalue, tbase, iname, s); */
 	    SwigType_typename_replace(s, name, dvalue);
@@ -376,6 +589,8 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 	  sz = Len(cpatchlist);
 	  for (i = 0; i < sz; i++) {
 	    String *s = Getitem(cpatchlist, i);
+	    if (uses[2] && !(uses[2][i] & bit))
+	      continue;
 	    Replace(s, tmp, tmpr, DOH_REPLACE_ID);
 	    /*  Replace(s,name,tydef, DOH_REPLACE_ID); */
 	    Replace(s, name, valuestr, DOH_REPLACE_ID);
@@ -390,7 +605,11 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 	tp = nextSibling(tp);
 	if (!p)
 	  p = tp;
+	k++;
       }
+      for (k = 0; k < 3; k++)
+	free(uses[k]);
+      Delete(names);
     } else {
       /* No template parameters at all.  This could be a specialization */
       int i, sz;
@@ -415,6 +634,7 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
       }
     }
   }
+  template_plan_located = 0;
   Delete(patchlist);
   Delete(cpatchlist);
   Delete(typelist);
@@ -423,6 +643,7 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
   Delete(templateargs);
 
   /*  set_nodeType(n,"template"); */
+  Swig_stats_end(SWIG_STATS_TEMPLATE_EXPAND, stats_start, rname, 0);
   return 0;
 }
 
@@ -434,24 +655,22 @@ typedef enum { ExactNoMatch = -2, PartiallySpecializedNoMatch = -1, PartiallySpe
  * Template argument deduction - check if a template type matches a partially specialized 
  * template parameter type. Typedef reduce 'partial_parm_type' to see if it matches 'type'.
  *
- * type - template parameter type to match against
+ * type - template parameter type to match against, typedef reduced in the template scope
+ * typebase - base type of type
  * partial_parm_type - partially specialized template type - a possible match
  * partial_parm_type_base - base type of partial_parm_type
- * tscope - template scope
  * specialization_priority - (output) contains a value indicating how good the match is 
  *   (higher is better) only set if return is set to PartiallySpecializedMatch or ExactMatch.
  * ----------------------------------------------------------------------------- */
 
-static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const char *partial_parm_type_base, Symtab *tscope, int *specialization_priority) {
+static EMatch does_parm_match(SwigType *type, String *typebase, SwigType *partial_parm_type, const char *partial_parm_type_base, int *specialization_priority) {
   static const int EXACT_MATCH_PRIORITY = 99999; /* a number bigger than the length of any conceivable type */
   int matches;
   int substitutions;
   EMatch match;
-  SwigType *ty = Swig_symbol_typedef_reduce(type, tscope);
-  String *base = SwigType_base(ty);
   SwigType *t = Copy(partial_parm_type);
-  substitutions = Replaceid(t, partial_parm_type_base, base); /* eg: Replaceid("p.$1", "$1", "int") returns t="p.int" */
-  matches = Equal(ty, t);
+  substitutions = Replaceid(t, partial_parm_type_base, typebase); /* eg: Replaceid("p.$1", "$1", "int") returns t="p.int" */
+  matches = Equal(type, t);
   *specialization_priority = -1;
   if (substitutions == 1) {
     /* we have a non-explicit specialized parameter (in partial_parm_type) because a substitution for $1, $2... etc has taken place */
@@ -469,7 +688,7 @@ static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const
     */
     Replaceid(tt, partial_parm_type_base, ""); /* remove the $1, $2 etc, eg tt="p.$1" => "p." */
     len = Len(tt);
-    if (Strncmp(tt, ty, len) == 0) {
+    if (Strncmp(tt, type, len) == 0) {
       match = PartiallySpecializedMatch;
       *specialization_priority = len;
     } else {
@@ -485,11 +704,187 @@ static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const
   Printf(stdout, "      does_parm_match %2d %5d [%s] [%s]\n", match, *specialization_priority, type, partial_parm_type);
   */
   Delete(t);
-  Delete(base);
-  Delete(ty);
   return match;
 }
 
+/* -----------------------------------------------------------------------------
+ * Partial specialization index
+ *
+ * Interfaces can have hundreds of partial specializations of a template.  The
+ * partial specializations of a primary template are indexed by the number of
+ * template parameters and by the leading element of the type of the first
+ * parameter, eg "p." in X<T *, U>.  A partial specialization can only match if
+ * its leading element is the same as the leading element of the typedef reduced
+ * template argument, unless the leading element contains a deduced parameter
+ * ($1, $2 ...), as in X<T, U>.  Each bucket holds its partial specializations
+ * in the order they were declared, as the order decides between ambiguous
+ * matches.
+ *
+ * The partial specializations chosen for a given set of typedef reduced
+ * template arguments are also memoized.  Both are discarded whenever a partial
+ * specialization is added.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+  List *partials;		/* the indexed "partials" list of the primary template */
+  int len;			/* number of partials indexed */
+  Hash *buckets;		/* "n" (all), "n:*" (deduced leading element) and "n:leading" */
+  Hash *chosen;			/* reduced template arguments => chosen partials */
+} PartialsIndex;
+
+static void partials_index_delete(void *ptr) {
+  PartialsIndex *index = (PartialsIndex *) ptr;
+  Delete(index->buckets);
+  Delete(index->chosen);
+  free(index);
+}
+
+/* Returns the first element of a type, or 0 if there is no type or it contains a deduced parameter */
+static String *partial_leading(const SwigType *ty) {
+  char *c = Char(ty);
+  char *start = c;
+  int level = 0;
+  String *leading;
+  if (!c)
+    return 0;
+  while (*c) {
+    if (*c == '(') {
+      level++;
+    } else if (*c == ')') {
+      level--;
+    } else if (*c == '.' && level == 0) {
+      c++;
+      break;
+    }
+    c++;
+  }
+  leading = NewStringWithSize(start, (int)(c - start));
+  if (Strchr(leading, '$')) {
+    Delete(leading);
+    return 0;
+  }
+  return leading;
+}
+
+static void partials_bucket_append(Hash *buckets, String *key, Node *partial) {
+  List *bucket = Getattr(buckets, key);
+  if (!bucket) {
+    String *k = Copy(key);	/* the key is reused by the caller */
+    bucket = NewList();
+    Setattr(buckets, k, bucket);
+    Delete(bucket);
+    Delete(k);
+  }
+  if (partial)
+    Append(bucket, partial);
+}
+
+static Hash *partials_indexes = 0;	/* template node address -> partials index */
+
+static PartialsIndex *partials_index(Node *templ) {
+  List *partials = Getattr(templ, "partials");
+  DOH *v;
+  PartialsIndex *index;
+  List *leadings;
+  Iterator pi;
+  Iterator li;
+  String *key;
+
+  if (!partials)
+    return 0;
+  if (!partials_indexes)
+    partials_indexes = NewHash();
+  key = NewStringf("%p", templ);
+  v = Getattr(partials_indexes, key);
+  index = v ? (PartialsIndex *) Data(v) : 0;
+  /* The node address may be reused by a later node, so check the index is for these partials */
+  if (index && index->partials == partials && index->len == Len(partials)) {
+    Delete(key);
+    return index;
+  }
+
+  index = (PartialsIndex *) malloc(sizeof(PartialsIndex));
+  index->partials = partials;
+  index->len = Len(partials);
+  index->buckets = NewHash();
+  index->chosen = NewHash();
+  v = NewVoid(index, partials_index_delete);
+  Setattr(partials_indexes, key, v);
+  Delete(v);
+  Delete(key);
+
+  /* Create the buckets of the leading elements first so that the partial
+     specializations with a deduced leading element go into each of them */
+  key = NewStringEmpty();
+  leadings = NewList();
+  for (pi = First(partials); pi.item; pi = Next(pi)) {
+    Parm *partialparms = Getattr(pi.item, "partialparms");
+    String *leading = partial_leading(Getattr(partialparms, "type"));
+    int arity = ParmList_len(partialparms);
+    Clear(key);
+    Printf(key, "%d", arity);
+    partials_bucket_append(index->buckets, key, 0);
+    Append(key, ":*");
+    partials_bucket_append(index->buckets, key, 0);
+    if (leading) {
+      Clear(key);
+      Printf(key, "%d:%s", arity, leading);
+      partials_bucket_append(index->buckets, key, 0);
+      Append(leadings, leading);
+      Delete(leading);
+    } else {
+      Append(leadings, "*");
+    }
+  }
+
+  for (pi = First(partials), li = First(leadings); pi.item; pi = Next(pi), li = Next(li)) {
+    int arity = ParmList_len(Getattr(pi.item, "partialparms"));
+    Clear(key);
+    Printf(key, "%d", arity);
+    partials_bucket_append(index->buckets, key, pi.item);
+    Printf(key, ":%s", li.item);
+    if (Equal(li.item, "*")) {
+      Iterator bi;
+      String *prefix = NewStringf("%d:", arity);
+      for (bi = First(index->buckets); bi.key; bi = Next(bi)) {
+	if (Strncmp(bi.key, prefix, Len(prefix)) == 0 && !Equal(bi.key, key))
+	  Append(bi.item, pi.item);
+      }
+      Delete(prefix);
+    }
+    partials_bucket_append(index->buckets, key, pi.item);
+  }
+  Delete(leadings);
+  Delete(key);
+  return index;
+}
+
+/* Returns the partial specializations that may match the typedef reduced template arguments */
+static List *partials_index_candidates(PartialsIndex *index, int arity, SwigType *ty) {
+  String *leading = ty ? partial_leading(ty) : 0;
+  String *key = NewStringf("%d", arity);
+  List *bucket;
+  if (ty) {
+    bucket = 0;
+    if (leading) {
+      Printf(key, ":%s", leading);
+      bucket = Getattr(index->buckets, key);
+      Clear(key);
+      Printf(key, "%d", arity);
+    }
+    if (!bucket) {
+      Append(key, ":*");
+      bucket = Getattr(index->buckets, key);
+    }
+  } else {
+    /* The first parameter is not checked */
+    bucket = Getattr(index->buckets, key);
+  }
+  Delete(key);
+  Delete(leading);
+  return bucket;
+}
+
 /* -----------------------------------------------------------------------------
  * template_locate()
  *
@@ -509,6 +904,13 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
   int *priorities_matrix = 0;
   int max_possible_partials = 0;
   int posslen = 0;
+  SwigType **reduced = 0;
+  String **reducedbases = 0;
+  int parms_len = 0;
+  int i;
+  PartialsIndex *index = 0;
+  String *chosenkey = 0;
+  int memoized = 0;
 
   /* Search for primary (unspecialized) template */
   templ = Swig_symbol_clookup(name, 0);
@@ -597,15 +999,40 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
      */
 
     /* Rank each template parameter against the desired template parameters then build a matrix of best matches */
-    possiblepartials = NewList();
-    {
+    index = partials_index(templ); /* note that the partial specializations do not include explicit specializations */
+    if (index) {
+      /* Typedef reduce the template arguments once for all the partial specializations */
+      parms_len = ParmList_len(parms);
+      reduced = (SwigType **)malloc(sizeof(SwigType *) * (parms_len + 1));
+      reducedbases = (String **)malloc(sizeof(String *) * (parms_len + 1));
+      chosenkey = NewStringf("%d", parms_len);
+      for (p = parms, i = 0; p; p = nextSibling(p), i++) {
+	SwigType *t = Getattr(p, "type");
+	if (!t)
+	  t = Getattr(p, "value");
+	reduced[i] = t ? Swig_symbol_typedef_reduce(t, tscope) : 0;
+	reducedbases[i] = t ? SwigType_base(reduced[i]) : 0;
+	if (t)
+	  Printf(chosenkey, " %d:%s", Len(reduced[i]), reduced[i]);
+	else
+	  Append(chosenkey, " -");
+      }
+      if (!template_debug) {
+	List *chosen = Getattr(index->chosen, chosenkey);
+	if (chosen) {
+	  possiblepartials = Copy(chosen);
+	  memoized = 1;
+	}
+      }
+    }
+
+    if (!possiblepartials) {
       char tmp[32];
-      List *partials;
+      List *partials = index ? partials_index_candidates(index, parms_len, parms_len > 0 ? reduced[0] : 0) : 0;
 
-      partials = Getattr(templ, "partials"); /* note that these partial specializations do not include explicit specializations */
+      possiblepartials = NewList();
       if (partials) {
 	Iterator pi;
-	int parms_len = ParmList_len(parms);
 	int *priorities_row;
 	max_possible_partials = Len(partials);
 	priorities_matrix = (int *)malloc(sizeof(int) * max_possible_partials * parms_len); /* slightly wasteful allocation for max possible matches */
@@ -628,7 +1055,7 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
 	      if (!t)
 		t = Getattr(p, "value");
 	      if (t) {
-		EMatch match = does_parm_match(t, Getattr(pp, "type"), tmp, tscope, priorities_row + i - 1);
+		EMatch match = does_parm_match(reduced[i - 1], reducedbases[i - 1], Getattr(pp, "type"), tmp, priorities_row + i - 1);
 		if (match < (int)PartiallySpecializedMatch) {
 		  all_parameters_match = 0;
 		  break;
@@ -662,7 +1089,7 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
       }
     }
 
-    if (posslen > 1) {
+    if (posslen > 1 && !memoized) {
       /* Now go through all the possibly matched partial specialization templates and look for a non-ambiguous match.
        * Exact matches rank the highest and deduced parameters are ranked by how specialized they are, eg looking for
        * a match to const int *, the following rank (highest to lowest):
@@ -754,6 +1181,9 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
       }
     }
 
+    if (index && !memoized)
+      Setattr(index->chosen, chosenkey, possiblepartials);
+
     if (posslen > 0) {
       String *s = Getattr(Getitem(possiblepartials, 0), "templcsymname");
       n = Swig_symbol_clookup_local(s, primary_scope);
@@ -806,6 +1236,13 @@ success:
   }
   Delete(parms);
   free(priorities_matrix);
+  for (i = 0; reduced && i < parms_len; i++) {
+    Delete(reduced[i]);
+    Delete(reducedbases[i]);
+  }
+  free(reduced);
+  free(reducedbases);
+  Delete(chosenkey);
   return n;
 }
 
@@ -827,6 +1264,9 @@ Node *Swig_cparse_template_locate(String *name, Parm *tparms, Symtab *tscope) {
     int isclass = 0;
     assert(Equal(nodeType, "template"));
     isclass = (Equal(Getattr(n, "templatetype"), "class"));
+    template_plan_located = 0;
+    if (isclass)
+      template_plan_locate(n);
     if (!isclass) {
       /* If not a templated class we must have a templated function.
          The template found is not necessarily the one we want when dealing with templated
@@ -334,6 +334,9 @@ int DohIsMapping(const DOH *obj) {
 DOH *DohGetattr(DOH *obj, const DOH *name) {
   DohBase *b = (DohBase *) obj;
   DohObjInfo *objinfo = b->type;
+  DohStatsCalls[DOH_STATS_GETATTR]++;
+  if (DohStatsKeysOn)
+    DohStatsKey(DOH_STATS_GETATTR, name);
   if (objinfo->doh_hash && objinfo->doh_hash->doh_getattr) {
     DOH *r = (objinfo->doh_hash->doh_getattr) (b, (DOH *) name);
     return (r == DohNone) ? 0 : r;
@@ -348,6 +351,9 @@ DOH *DohGetattr(DOH *obj, const DOH *name) {
 int DohSetattr(DOH *obj, const DOH *name, const DOH *value) {
   DohBase *b = (DohBase *) obj;
   DohObjInfo *objinfo = b->type;
+  DohStatsCalls[DOH_STATS_SETATTR]++;
+  if (DohStatsKeysOn)
+    DohStatsKey(DOH_STATS_SETATTR, name);
   if (objinfo->doh_hash && objinfo->doh_hash->doh_setattr) {
     return (objinfo->doh_hash->doh_setattr) (b, (DOH *) name, (DOH *) value);
   }
@@ -115,6 +115,10 @@
 #define DohObjMalloc       DOH_NAMESPACE(ObjMalloc)
 #define DohObjFree         DOH_NAMESPACE(ObjFree)
 #define DohMemoryDebug     DOH_NAMESPACE(MemoryDebug)
+#define DohMemoryAllocated DOH_NAMESPACE(MemoryAllocated)
+#define DohStatsCalls      DOH_NAMESPACE(StatsCalls)
+#define DohStatsKeys       DOH_NAMESPACE(StatsKeys)
+#define DohStatsKeyCounts  DOH_NAMESPACE(StatsKeyCounts)
 #define DohStringType      DOH_NAMESPACE(StringType)
 #define DohListType        DOH_NAMESPACE(ListType)
 #define DohHashType        DOH_NAMESPACE(HashType)
@@ -334,6 +338,17 @@ extern DOHList *DohSplitLines(DOHFile * input);
 extern DOH *DohNone;
 
 extern void DohMemoryDebug(void);
+extern int DohMemoryAllocated(void);
+
+/* Call statistics */
+#define DOH_STATS_GETATTR  0
+#define DOH_STATS_SETATTR  1
+#define DOH_STATS_CHECK    2
+#define DOH_STATS_MAX      3
+
+extern unsigned long DohStatsCalls[DOH_STATS_MAX];
+extern void DohStatsKeys(int flag);
+extern DOH *DohStatsKeyCounts(int which);
 
 #ifndef DOH_LONG_NAMES
 /* Macros to invoke the above functions.  Includes the location of
@@ -129,4 +129,7 @@ typedef struct {
 extern DOH *DohObjMalloc(DohObjInfo *type, void *data);	/* Allocate a DOH object */
 extern void DohObjFree(DOH *ptr);	/* Free a DOH object     */
 
+extern int DohStatsKeysOn;	/* Count attribute names (DohStatsKeys()) */
+extern void DohStatsKey(int which, const DOH *name);
+
 #endif				/* DOHINT_H */
@@ -42,6 +42,7 @@ typedef struct pool {
 static DohBase *FreeList = 0;	/* List of free objects */
 static Pool *Pools = 0;
 static int pools_initialized = 0;
+static int num_allocated = 0;	/* Number of objects allocated so far */
 
 /* ----------------------------------------------------------------------
  * CreatePool() - Create a new memory pool 
@@ -85,6 +86,7 @@ static void InitPools() {
 int DohCheck(const DOH *ptr) {
   register Pool *p = Pools;
   register char *cptr = (char *) ptr;
+  DohStatsCalls[DOH_STATS_CHECK]++;
   while (p) {
     if ((cptr >= p->pbeg) && (cptr < p->pend)) {
 #ifdef DOH_DEBUG_MEMORY_POOLS
@@ -135,6 +137,7 @@ DOH *DohObjMalloc(DohObjInfo *type, void *data) {
 #ifndef DOH_DEBUG_MEMORY_POOLS
   }
 #endif
+  num_allocated++;
   obj->type = type;
   obj->data = data;
   obj->meta = 0;
@@ -166,6 +169,60 @@ void DohObjFree(DOH *ptr) {
   }
 }
 
+/* ----------------------------------------------------------------------
+ * DohMemoryAllocated()
+ *
+ * Number of objects allocated since startup (including freed objects)
+ * ---------------------------------------------------------------------- */
+
+int DohMemoryAllocated(void) {
+  return num_allocated;
+}
+
+/* ----------------------------------------------------------------------
+ * Call statistics
+ *
+ * DohStatsCalls[] counts the calls of the most frequently used operations.
+ * After DohStatsKeys(1), Getattr and Setattr calls are also counted for each
+ * attribute name.  DohStatsKeyCounts() returns a hash of these counts, each
+ * held as an unsigned long in a Void object.
+ * ---------------------------------------------------------------------- */
+
+unsigned long DohStatsCalls[DOH_STATS_MAX];
+int DohStatsKeysOn = 0;
+static DOH *StatsKeys[DOH_STATS_MAX];
+
+void DohStatsKeys(int flag) {
+  int i;
+  for (i = 0; i < DOH_STATS_MAX; i++) {
+    if (flag && !StatsKeys[i])
+      StatsKeys[i] = NewHash();
+  }
+  DohStatsKeysOn = flag;
+}
+
+DOH *DohStatsKeyCounts(int which) {
+  return StatsKeys[which];
+}
+
+void DohStatsKey(int which, const DOH *name) {
+  DOH *v;
+  /* The statistics hash is itself accessed with Getattr/Setattr */
+  DohStatsKeysOn = 0;
+  v = Getattr(StatsKeys[which], name);
+  if (!v) {
+    unsigned long *count = (unsigned long *) DohMalloc(sizeof(unsigned long));
+    DOH *key = DohCheck(name) ? Copy(name) : NewString(name);
+    *count = 0;
+    v = NewVoid(count, DohFree);
+    Setattr(StatsKeys[which], key, v);
+    Delete(key);
+    Delete(v);
+  }
+  (*(unsigned long *) Data(v))++;
+  DohStatsKeysOn = 1;
+}
+
 /* ----------------------------------------------------------------------
  * DohMemoryDebug()
  *
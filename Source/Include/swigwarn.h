@@ -241,6 +241,7 @@
 #define WARN_JAVA_TYPEMAP_JAVACONSTRUCT_UNDEF 823
 #define WARN_JAVA_TYPEMAP_DIRECTORIN_NODESC   824
 #define WARN_JAVA_NO_DIRECTORCONNECT_ATTR     825
+#define WARN_JAVA_TYPEMAP_CLEANER_MISMATCH    826
 
 /* please leave 810-829 free for Java */
 
@@ -260,6 +261,7 @@
 #define WARN_CSHARP_EXCODE                    844
 #define WARN_CSHARP_CANTHROW                  845
 #define WARN_CSHARP_NO_DIRECTORCONNECT_ATTR   846
+#define WARN_CSHARP_STRUCT_MEMBER_IGNORED     847
 
 /* please leave 830-849 free for C# */
 
@@ -284,6 +286,7 @@
 /* please leave 870-889 free for PHP */
 
 #define WARN_GO_NAME_CONFLICT                 890
+#define WARN_GO_STRUCT_MEMBER_IGNORED         891
 
 /* please leave 890-899 free for Go */
 
@@ -951,3 +951,14 @@ void Swig_default_allocators(Node *n) {
   a->top(n);
   delete a;
 }
+
+/* Returns the allocators pass to run on each top level declaration straight
+   after Swig_process_types() has processed it, or 0 if it must be run over the
+   whole tree afterwards with Swig_default_allocators().  Virtual elimination
+   ignores methods that a later using declaration in a derived class must still
+   see, so it needs the separate passes. */
+Dispatcher *Swig_default_allocators_fused() {
+  if (virtual_elimination_mode)
+    return 0;
+  return new Allocate;
+}
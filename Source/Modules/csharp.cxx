@@ -768,6 +768,7 @@ public:
       String *imtypeout = Getattr(n, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
       if (imtypeout)
 	tm = imtypeout;
+      substituteClassname(t, tm);
       Printf(im_return_type, "%s", tm);
       im_outattributes = Getattr(n, "tmap:imtype:outattributes");
     } else {
@@ -834,6 +835,7 @@ public:
 
       /* Get the intermediary class parameter types of the parameter */
       if ((tm = Getattr(p, "tmap:imtype"))) {
+	substituteClassname(pt, tm);
 	const String *inattributes = Getattr(p, "tmap:imtype:inattributes");
 	Printf(im_param_type, "%s%s", inattributes ? inattributes : empty_string, tm);
       } else {
@@ -1624,7 +1626,7 @@ public:
       List *baselist = Getattr(n, "bases");
       if (baselist) {
         Iterator base = First(baselist);
-        while (base.item && GetFlag(base.item, "feature:ignore")) {
+        while (base.item && (GetFlag(base.item, "feature:ignore") || GetFlag(base.item, "feature:cs:struct"))) {
           base = Next(base);
         }
         if (base.item) {
@@ -1635,7 +1637,7 @@ public:
           base = Next(base);
           /* Warn about multiple inheritance for additional base class(es) */
           while (base.item) {
-            if (GetFlag(base.item, "feature:ignore")) {
+            if (GetFlag(base.item, "feature:ignore") || GetFlag(base.item, "feature:cs:struct")) {
               base = Next(base);
               continue;
             }
@@ -1868,6 +1870,9 @@ public:
 
     String *nspace = getNSpace();
     File *f_proxy = NULL;
+    if (proxy_flag && GetFlag(n, "feature:cs:struct"))
+      return structHandler(n);
+
     if (proxy_flag) {
       proxy_class_name = NewString(Getattr(n, "sym:name"));
 
@@ -2007,6 +2012,170 @@ public:
     return SWIG_OK;
   }
 
+  /* ----------------------------------------------------------------------
+   * structFieldType()
+   *
+   * The C# type of a data member in a class wrapped as a C# struct or NULL if
+   * the type is not blittable. Only fixed size primitive types and other
+   * classes wrapped as C# structs have the same layout in C# and C++.
+   * ---------------------------------------------------------------------- */
+
+  String *structFieldType(SwigType *t) {
+    SwigType *resolved = SwigType_typedef_resolve_all(t);
+    SwigType *stripped = SwigType_strip_qualifiers(resolved);
+    String *cstype = NULL;
+
+    switch (SwigType_type(stripped)) {
+    case T_SCHAR:
+      cstype = NewString("sbyte");
+      break;
+    case T_UCHAR:
+      cstype = NewString("byte");
+      break;
+    case T_SHORT:
+      cstype = NewString("short");
+      break;
+    case T_USHORT:
+      cstype = NewString("ushort");
+      break;
+    case T_INT:
+      cstype = NewString("int");
+      break;
+    case T_UINT:
+      cstype = NewString("uint");
+      break;
+    case T_LONGLONG:
+      cstype = NewString("long");
+      break;
+    case T_ULONGLONG:
+      cstype = NewString("ulong");
+      break;
+    case T_FLOAT:
+      cstype = NewString("float");
+      break;
+    case T_DOUBLE:
+      cstype = NewString("double");
+      break;
+    case T_USER:
+      {
+	Node *cls = classLookup(stripped);
+	if (cls && GetFlag(cls, "feature:cs:struct"))
+	  cstype = Copy(getProxyName(stripped));
+      }
+      break;
+    default:
+      break;
+    }
+    Delete(stripped);
+    Delete(resolved);
+    return cstype;
+  }
+
+  /* ----------------------------------------------------------------------
+   * structHandler()
+   *
+   * Generate a blittable C# struct for a class marked with %csstruct. The
+   * struct is marshalled by value, so it only works if the C# fields line up
+   * with the C++ data members: all of them are emitted in declaration order
+   * and they must share one access level (a standard-layout class). Methods,
+   * constructors and static members have no place in the struct; each public
+   * one is reported as ignored.
+   * ---------------------------------------------------------------------- */
+
+  int structHandler(Node *n) {
+    String *nspace = getNSpace();
+    String *symname = Getattr(n, "sym:name");
+    SwigType *typemap_lookup_type = Getattr(n, "classtypeobj");
+    String *classname = SwigType_namestr(typemap_lookup_type);
+    String *fields = NewString("");
+    const char *field_access = 0;
+    int result = SWIG_OK;
+
+    if (Getattr(n, "bases")) {
+      Swig_error(Getfile(n), Getline(n), "%%csstruct %s cannot be used on a derived class.\n", classname);
+      result = SWIG_ERROR;
+    }
+
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+      String *ntype = nodeType(c);
+      String *name = Getattr(c, "sym:name") ? Getattr(c, "sym:name") : Getattr(c, "name");
+      if (checkAttribute(c, "storage", "virtual")) {
+	Swig_error(Getfile(c), Getline(c), "%%csstruct %s has a virtual method %s, so it has no C# struct equivalent.\n", classname, name);
+	result = SWIG_ERROR;
+	continue;
+      }
+      if (Cmp(ntype, "cdecl") == 0 && checkAttribute(c, "kind", "variable") && !checkAttribute(c, "storage", "static")) {
+	const char *access = is_public(c) ? "public" : is_protected(c) ? "protected" : "private";
+	String *cstype = Getattr(c, "bitfield") ? NULL : structFieldType(Getattr(c, "type"));
+	if (!cstype) {
+	  Swig_error(Getfile(c), Getline(c), "Field %s of %%csstruct %s has type %s, which has no blittable C# type.\n",
+		     name, classname, SwigType_str(Getattr(c, "type"), 0));
+	  result = SWIG_ERROR;
+	  continue;
+	}
+	if (!field_access) {
+	  field_access = access;
+	} else if (strcmp(field_access, access) != 0) {
+	  Swig_error(Getfile(c), Getline(c), "Field %s of %%csstruct %s is %s but an earlier field is %s; the layout of a class mixing access levels is not fixed.\n",
+		     name, classname, access, field_access);
+	  result = SWIG_ERROR;
+	}
+	Printf(fields, "  %s %s %s;\n", is_public(c) ? "public" : "private", cstype, name);
+	Delete(cstype);
+      } else if ((Cmp(ntype, "cdecl") == 0 || Cmp(ntype, "constructor") == 0 || Cmp(ntype, "destructor") == 0) && is_public(c) && !GetFlag(c, "feature:ignore")
+		 && !GetFlag(c, "default_constructor") && !GetFlag(c, "default_destructor")) {
+	String *wrn = Getattr(c, "feature:warnfilter");
+	if (wrn)
+	  Swig_warnfilter(wrn, 1);
+	Swig_warning(WARN_CSHARP_STRUCT_MEMBER_IGNORED, Getfile(c), Getline(c), "%s of %%csstruct %s ignored, only the data members are wrapped in the C# struct.\n",
+		     Swig_name_decl(c), classname);
+	if (wrn)
+	  Swig_warnfilter(wrn, 0);
+      }
+    }
+
+    if (result == SWIG_OK && !addSymbol(symname, n, nspace))
+      result = SWIG_ERROR;
+
+    if (result == SWIG_OK) {
+      String *output_directory = outputDirectory(nspace);
+      String *filen = NewStringf("%s%s.cs", output_directory, symname);
+      File *f_struct = NewFile(filen, "w", SWIG_output_files());
+      if (!f_struct) {
+	FileErrorDisplay(filen);
+	SWIG_exit(EXIT_FAILURE);
+      }
+      Append(filenames_list, Copy(filen));
+      Delete(filen);
+
+      String *struct_code = NewString("");
+      Printv(struct_code, typemapLookup(n, "csimports", typemap_lookup_type, WARN_NONE),	// Import statements
+	     "\n", NIL);
+      const String *csattributes = typemapLookup(n, "csattributes", typemap_lookup_type, WARN_NONE);
+      if (csattributes && *Char(csattributes))
+	Printf(struct_code, "%s\n", csattributes);
+      Printv(struct_code, typemapLookup(n, "csclassmodifiers", typemap_lookup_type, WARN_CSHARP_TYPEMAP_CLASSMOD_UNDEF),	// Class modifiers
+	     " $csclassname {\n", fields,
+	     typemapLookup(n, "cscode", typemap_lookup_type, WARN_NONE),	// extra C# code
+	     "}\n", NIL);
+      Replaceall(struct_code, "$csclassname", symname);
+      Replaceall(struct_code, "$module", module_class_name);
+      Replaceall(struct_code, "$imclassname", imclass_name);
+      Replaceall(struct_code, "$dllimport", dllimport);
+
+      emitBanner(f_struct);
+      addOpenNamespace(nspace, f_struct);
+      Printv(f_struct, struct_code, NIL);
+      addCloseNamespace(nspace, f_struct);
+      Close(f_struct);
+      Delete(struct_code);
+      Delete(output_directory);
+    }
+
+    Delete(fields);
+    return result;
+  }
+
   /* ----------------------------------------------------------------------
    * memberfunctionHandler()
    * ---------------------------------------------------------------------- */
@@ -3548,9 +3717,12 @@ public:
 
       tm = Swig_typemap_lookup("imtype", tp, "", 0);
       if (tm) {
-	String *imtypeout = Getattr(tp, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
+	String *imtypeout = Getattr(tp, "tmap:imtype:directorout");	// the type in the imtype typemap's directorout attribute overrides the type in the out attribute
+	if (!imtypeout)
+	  imtypeout = Getattr(tp, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
 	if (imtypeout)
 	  tm = imtypeout;
+	substituteClassname(returntype, tm);
         const String *im_directoroutattributes = Getattr(tp, "tmap:imtype:directoroutattributes");
         if (im_directoroutattributes) {
           Printf(callback_def, "  %s\n", im_directoroutattributes);
@@ -3570,7 +3742,10 @@ public:
 
 	if (!is_void && !ignored_method) {
 	  String *jretval_decl = NewStringf("%s jresult", c_ret_type);
-	  Wrapper_add_localv(w, "jresult", jretval_decl, "= 0", NIL);
+	  /* A C# struct is passed by value and cannot be initialized with 0 */
+	  Node *retclass = classLookup(returntype);
+	  bool cs_struct = retclass && GetFlag(retclass, "feature:cs:struct") && !Strchr(c_ret_type, '*');
+	  Wrapper_add_localv(w, "jresult", jretval_decl, cs_struct ? "" : "= 0", NIL);
 	  Delete(jretval_decl);
 	}
       } else {
@@ -3641,9 +3816,10 @@ public:
 	  c_param_type = ctypeout;
 
 	/* Add to local variables */
+	/* A non pointer type from the out attribute, such as a struct, cannot be initialized with 0 */
 	Printf(c_decl, "%s %s", c_param_type, arg);
 	if (!ignored_method)
-	  Wrapper_add_localv(w, arg, c_decl, (!(SwigType_ispointer(pt) || SwigType_isreference(pt)) ? "" : "= 0"), NIL);
+	  Wrapper_add_localv(w, arg, c_decl, ((ctypeout && !Strchr(ctypeout, '*')) || !(SwigType_ispointer(pt) || SwigType_isreference(pt)) ? "" : "= 0"), NIL);
 
 	/* Add input marshalling code */
 	if ((tm = Getattr(p, "tmap:directorin"))) {
@@ -3668,6 +3844,7 @@ public:
 	    String *imtypeout = Getattr(p, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
 	    if (imtypeout)
 	      tm = imtypeout;
+	    substituteClassname(pt, tm);
             const String *im_directorinattributes = Getattr(p, "tmap:imtype:directorinattributes");
 
 	    String *din = Copy(Getattr(p, "tmap:csdirectorin"));
@@ -1126,6 +1126,9 @@ private:
     }
 
     String *go = goType(n, type);
+    SwigType *base = SwigType_base(type);
+    Node *go_struct = *Char(go) != '*' ? goStructLookup(base) : NULL;
+    Delete(base);
     if (Cmp(go, "string") == 0) {
       // A string has a pointer and a length.
       Append(orig, "(2 * SWIG_PARM_SIZE)");
@@ -1139,6 +1142,20 @@ private:
       Append(orig, "8");
     } else if (Strcmp(go, "complex128") == 0) {
       Append(orig, "16");
+    } else if (go_struct) {
+      // A Go struct passed by value, rounded up to a whole number of
+      // parameter slots.  8 byte scalars are only 4 byte aligned on
+      // 32-bit targets, so the size may depend on SWIG_PARM_SIZE.
+      int size32;
+      int size64;
+      int align;
+      goStructLayout(go_struct, 4, &size32, &align);
+      goStructLayout(go_struct, 8, &size64, &align);
+      if (size32 == size64) {
+	Printf(orig, "((%d + SWIG_PARM_SIZE - 1) & ~(SWIG_PARM_SIZE - 1))", size64);
+      } else {
+	Printf(orig, "(((SWIG_PARM_SIZE == 4 ? %d : %d) + SWIG_PARM_SIZE - 1) & ~(SWIG_PARM_SIZE - 1))", size32, size64);
+      }
     } else {
       Append(orig, "SWIG_PARM_SIZE");
     }
@@ -1821,6 +1838,20 @@ private:
       return SWIG_NOWRAP;
     }
 
+    if (GetFlag(n, "feature:go:struct")) {
+      int r = goStructHandler(n, go_name);
+      Delete(go_name);
+      return r;
+    }
+
+    for (Iterator b = First(baselist); b.item; b = Next(b)) {
+      if (GetFlag(b.item, "feature:go:struct")) {
+	Swig_error(Getfile(n), Getline(n), "Class %s cannot be derived from %s which has the go:struct feature.\n", SwigType_namestr(Getattr(n, "name")), SwigType_namestr(Getattr(b.item, "name")));
+	Delete(go_name);
+	return SWIG_ERROR;
+      }
+    }
+
     String *go_type_name = goCPointerType(Getattr(n, "classtypeobj"), true);
 
     class_name = name;
@@ -1935,6 +1966,218 @@ private:
     return SWIG_OK;
   }
 
+  /* ------------------------------------------------------------
+   * goStructHandler()
+   *
+   * Emit a Go struct type for a class marked with %gostruct.  Values
+   * of the type are copied to and from C++ as raw memory, so the Go
+   * fields must match the C++ layout exactly: every data member is
+   * emitted in order, and they must all have the same access, which
+   * makes the class standard-layout.  Anything else in the class
+   * cannot be reached from the Go struct, so each public method,
+   * constructor or static member gets a warning.
+   * ------------------------------------------------------------ */
+
+  int goStructHandler(Node *n, String *go_name) {
+    int r = SWIG_OK;
+    String *cname = SwigType_namestr(Getattr(n, "name"));
+
+    if (Getattr(n, "bases")) {
+      Swig_error(Getfile(n), Getline(n), "%s has base classes, which %%gostruct does not support.\n", cname);
+      r = SWIG_ERROR;
+    }
+
+    String *fields = NewString("");
+    const char *first_access = NULL;
+    for (Node *ni = firstChild(n); ni; ni = nextSibling(ni)) {
+      String *type = nodeType(ni);
+      String *name = Getattr(ni, "sym:name");
+      if (!name) {
+	name = Getattr(ni, "name");
+      }
+
+      if (checkAttribute(ni, "storage", "virtual")) {
+	Swig_error(Getfile(ni), Getline(ni), "%%gostruct %s: virtual function %s would need a vtable pointer in the Go struct.\n", cname, name);
+	r = SWIG_ERROR;
+	continue;
+      }
+
+      bool is_field = Cmp(type, "cdecl") == 0 && checkAttribute(ni, "kind", "variable") && !checkAttribute(ni, "storage", "static");
+      if (!is_field) {
+	bool is_member = Cmp(type, "cdecl") == 0 || Cmp(type, "constructor") == 0 || Cmp(type, "destructor") == 0;
+	if (is_member && is_public(ni) && !GetFlag(ni, "feature:ignore") && !GetFlag(ni, "default_constructor") && !GetFlag(ni, "default_destructor")) {
+	  String *wrn = Getattr(ni, "feature:warnfilter");
+	  if (wrn) {
+	    Swig_warnfilter(wrn, 1);
+	  }
+	  Swig_warning(WARN_GO_STRUCT_MEMBER_IGNORED, Getfile(ni), Getline(ni), "No Go wrapper for %s, %%gostruct %s is wrapped as plain data.\n", Swig_name_decl(ni), cname);
+	  if (wrn) {
+	    Swig_warnfilter(wrn, 0);
+	  }
+	}
+	continue;
+      }
+
+      const char *access = is_public(ni) ? "public" : (is_protected(ni) ? "protected" : "private");
+      if (!first_access) {
+	first_access = access;
+      } else if (strcmp(access, first_access) != 0) {
+	Swig_error(Getfile(ni), Getline(ni), "%%gostruct %s: %s member %s follows %s members; the C++ layout of mixed access members is unspecified.\n",
+		   cname, access, name, first_access);
+	r = SWIG_ERROR;
+      }
+
+      int size;
+      int align;
+      String *gt = Getattr(ni, "bitfield") ? NULL : goStructFieldType(ni, Getattr(ni, "type"), 8, &size, &align);
+      if (!gt) {
+	Swig_error(Getfile(ni), Getline(ni), "%%gostruct %s: no Go type with the size of %s for member %s.\n",
+		   cname, SwigType_str(Getattr(ni, "type"), 0), name);
+	r = SWIG_ERROR;
+	continue;
+      }
+      String *field_name;
+      if (is_public(ni)) {
+	field_name = exportedName(name);
+      } else {
+	field_name = NewString("swig_");
+	Append(field_name, name);
+      }
+      Printv(fields, "\t", field_name, " ", gt, "\n", NULL);
+      Delete(field_name);
+      Delete(gt);
+    }
+
+    if (r == SWIG_OK) {
+      Printv(f_go_wrappers, "type ", go_name, " struct {\n", fields, "}\n\n", NULL);
+      Setattr(defined_types, go_name, go_name);
+    }
+
+    Delete(fields);
+    return r;
+  }
+
+  /* ------------------------------------------------------------
+   * goStructFieldType()
+   *
+   * Return the Go type of a data member of a class with the go:struct
+   * feature, and set its size and alignment, or return NULL if the
+   * type has no fixed size Go equivalent.  The alignment of a scalar
+   * is at most word_size, the pointer size of the target, as 8 byte
+   * scalars are 4 byte aligned on 32-bit targets.
+   * ------------------------------------------------------------ */
+
+  String *goStructFieldType(Node *n, SwigType *type, int word_size, int *size, int *align) {
+    SwigType *t = SwigType_typedef_resolve_all(type);
+    SwigType *s = SwigType_strip_qualifiers(t);
+    String *ret = NULL;
+    *size = 0;
+
+    switch (SwigType_type(s)) {
+    case T_CHAR:
+      ret = NewString("byte");
+      *size = 1;
+      break;
+    case T_SCHAR:
+      ret = NewString("int8");
+      *size = 1;
+      break;
+    case T_UCHAR:
+      ret = NewString("uint8");
+      *size = 1;
+      break;
+    case T_SHORT:
+      ret = NewString("int16");
+      *size = 2;
+      break;
+    case T_USHORT:
+      ret = NewString("uint16");
+      *size = 2;
+      break;
+    case T_INT:
+      ret = NewString("int32");
+      *size = 4;
+      break;
+    case T_UINT:
+      ret = NewString("uint32");
+      *size = 4;
+      break;
+    case T_LONG:
+      ret = NewString(long_type_size == 32 ? "int32" : "int64");
+      *size = long_type_size / 8;
+      break;
+    case T_ULONG:
+      ret = NewString(long_type_size == 32 ? "uint32" : "uint64");
+      *size = long_type_size / 8;
+      break;
+    case T_LONGLONG:
+      ret = NewString("int64");
+      *size = 8;
+      break;
+    case T_ULONGLONG:
+      ret = NewString("uint64");
+      *size = 8;
+      break;
+    case T_FLOAT:
+      ret = NewString("float32");
+      *size = 4;
+      break;
+    case T_DOUBLE:
+      ret = NewString("float64");
+      *size = 8;
+      break;
+    case T_USER:
+      {
+	Node *cn = goStructLookup(s);
+	if (cn) {
+	  ret = goType(n, s);
+	  goStructLayout(cn, word_size, size, align);
+	}
+      }
+      break;
+    default:
+      break;
+    }
+
+    if (ret && SwigType_type(s) != T_USER) {
+      *align = *size < word_size ? *size : word_size;
+    }
+
+    Delete(s);
+    Delete(t);
+    return ret;
+  }
+
+  /* ------------------------------------------------------------
+   * goStructLayout()
+   *
+   * Compute the size and alignment of a class with the go:struct
+   * feature from its data members, for a target with the given
+   * pointer size.
+   * ------------------------------------------------------------ */
+
+  void goStructLayout(Node *n, int word_size, int *size, int *align) {
+    *size = 0;
+    *align = 1;
+    for (Node *ni = firstChild(n); ni; ni = nextSibling(ni)) {
+      if (Cmp(nodeType(ni), "cdecl") != 0 || checkAttribute(ni, "storage", "static") || !checkAttribute(ni, "kind", "variable")) {
+	continue;
+      }
+      int field_size;
+      int field_align;
+      String *gt = goStructFieldType(ni, Getattr(ni, "type"), word_size, &field_size, &field_align);
+      if (!gt) {
+	continue;
+      }
+      Delete(gt);
+      *size = (*size + field_align - 1) / field_align * field_align + field_size;
+      if (field_align > *align) {
+	*align = field_align;
+      }
+    }
+    *size = (*size + *align - 1) / *align * *align;
+  }
+
   /* ------------------------------------------------------------
    * addBase()
    *
@@ -4401,12 +4644,21 @@ private:
 
 	Node *cnmod = Getattr(cn, "module");
 	if (!cnmod || Strcmp(Getattr(cnmod, "name"), module) == 0) {
+	  if (GetFlag(cn, "feature:go:struct")) {
+	    // A Go struct is passed by value, not as an interface.
+	    Delete(t);
+	    return ret;
+	  }
 	  Setattr(undefined_types, t, t);
 	} else {
 	  String *nw = NewString("");
 	  Printv(nw, Getattr(cnmod, "name"), ".", ret, NULL);
 	  Delete(ret);
 	  ret = nw;
+	  if (GetFlag(cn, "feature:go:struct")) {
+	    Delete(t);
+	    return ret;
+	  }
 	}
       } else {
 	// SWIG does not know about this type.
@@ -4476,14 +4728,15 @@ private:
       SwigType_del_reference(r);
 
       // If this is a const reference, and we are looking at a pointer
-      // to it, then we just use the pointer we already have.
+      // to it, then we just use the pointer we already have.  A const
+      // reference to a Go struct is passed by value.
       bool add_pointer = true;
       if (SwigType_isqualifier(r)) {
 	String *q = SwigType_parm(r);
 	if (Strcmp(q, "const") == 0) {
 	  SwigType *c = Copy(r);
 	  SwigType_del_qualifier(c);
-	  if (SwigType_ispointer(c)) {
+	  if (SwigType_ispointer(c) || goStructLookup(c)) {
 	    add_pointer = false;
 	  }
 	  Delete(c);
@@ -4672,7 +4925,7 @@ private:
 	  String *q = SwigType_parm(t);
 	  if (Strcmp(q, "const") == 0) {
 	    SwigType_del_qualifier(t);
-	    if (hasGoTypemap(n, t) || SwigType_ispointer(t)) {
+	    if (hasGoTypemap(n, t) || SwigType_ispointer(t) || goStructLookup(t)) {
 	      ret = SwigType_lstr(t, name);
 	      Delete(q);
 	      Delete(t);
@@ -4681,6 +4934,13 @@ private:
 	  }
 	  Delete(q);
 	}
+	// Any other reference to a Go struct is a pointer.
+	if (goStructLookup(t)) {
+	  SwigType_add_pointer(t);
+	  ret = SwigType_lstr(t, name);
+	  Delete(t);
+	  return ret;
+	}
       }
       Delete(t);
       if (is_char) {
@@ -4732,6 +4992,28 @@ private:
     return is_interface;
   }
 
+  /* ----------------------------------------------------------------------
+   * goStructLookup
+   *
+   * Return the class node if this C++ type is a class with the go:struct
+   * feature, ignoring qualifiers, and NULL otherwise.
+   * ---------------------------------------------------------------------- */
+
+  Node *goStructLookup(SwigType *type) {
+    SwigType *t = SwigType_typedef_resolve_all(type);
+    SwigType *s = SwigType_strip_qualifiers(t);
+    Node *cn = NULL;
+    if (SwigType_issimple(s)) {
+      cn = classLookup(s);
+      if (cn && !GetFlag(cn, "feature:go:struct")) {
+	cn = NULL;
+      }
+    }
+    Delete(s);
+    Delete(t);
+    return cn;
+  }
+
   /* ----------------------------------------------------------------------
    * hasGoTypemap
    *
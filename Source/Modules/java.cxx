@@ -1687,6 +1687,7 @@ public:
     String *c_baseclass = NULL;
     String *baseclass = NULL;
     String *c_baseclassname = NULL;
+    Node *base_node = NULL;
     SwigType *typemap_lookup_type = Getattr(n, "classtypeobj");
     bool feature_director = Swig_directorclass(n) ? true : false;
 
@@ -1706,6 +1707,7 @@ public:
           base = Next(base);
         }
         if (base.item) {
+          base_node = base.item;
           c_baseclassname = Getattr(base.item, "name");
           baseclass = Copy(getProxyName(c_baseclassname));
           if (baseclass)
@@ -1748,15 +1750,28 @@ public:
     // Pure Java interfaces
     const String *pure_interfaces = typemapLookup(n, "javainterfaces", typemap_lookup_type, WARN_NONE);
 
+    // Main body of class, the cleaner attribute marks a body using a Cleaner instead of finalize()
+    attributes = NewHash();
+    const String *body = typemapLookup(n, derived ? "javabody_derived" : "javabody", typemap_lookup_type, WARN_JAVA_TYPEMAP_JAVABODY_UNDEF, attributes);
+    bool body_cleaner = GetFlag(attributes, derived ? "tmap:javabody_derived:cleaner" : "tmap:javabody:cleaner") ? true : false;
+    Delete(attributes);
+    Setattr(n, "java:cleaner", body_cleaner ? "1" : "0");
+
     // Start writing the proxy class
     Printv(proxy_class_def, typemapLookup(n, "javaimports", typemap_lookup_type, WARN_NONE),	// Import statements
 	   "\n", typemapLookup(n, "javaclassmodifiers", typemap_lookup_type, WARN_JAVA_TYPEMAP_CLASSMOD_UNDEF),	// Class modifiers
 	   " $javaclassname",	// Class name and bases
 	   (*Char(wanted_base)) ? " extends " : "", wanted_base, *Char(pure_interfaces) ?	// Pure Java interfaces
-	   " implements " : "", pure_interfaces, " {", derived ? typemapLookup(n, "javabody_derived", typemap_lookup_type, WARN_JAVA_TYPEMAP_JAVABODY_UNDEF) :	// main body of class
-	   typemapLookup(n, "javabody", typemap_lookup_type, WARN_JAVA_TYPEMAP_JAVABODY_UNDEF),	// main body of class
+	   " implements " : "", pure_interfaces, " {", body,	// main body of class
 	   NIL);
 
+    // A Cleaner based body needs a Cleaner based base class
+    if (derived && base_node && Getattr(base_node, "java:cleaner") && GetFlag(base_node, "java:cleaner") != body_cleaner) {
+      Swig_warning(WARN_JAVA_TYPEMAP_CLEANER_MISMATCH, Getfile(n), Getline(n),
+		   "The javabody_derived typemap for %s %s a Cleaner but the javabody typemap for its base %s does%s. Use SWIG_JAVA_FINALIZER on both or neither.\n",
+		   c_classname, body_cleaner ? "uses" : "does not use", c_baseclass, body_cleaner ? " not" : "");
+    }
+
     // C++ destructor is wrapped by the delete method
     // Note that the method name is specified in a typemap attribute called methodname
     String *destruct = NewString("");
@@ -1774,6 +1789,12 @@ public:
       destruct_methodmodifiers = Getattr(attributes, "tmap:javadestruct:methodmodifiers");
     }
     if (tm && *Char(tm)) {
+      bool destruct_cleaner = GetFlag(attributes, derived ? "tmap:javadestruct_derived:cleaner" : "tmap:javadestruct:cleaner") ? true : false;
+      if (destruct_cleaner != body_cleaner) {
+	Swig_warning(WARN_JAVA_TYPEMAP_CLEANER_MISMATCH, Getfile(n), Getline(n),
+		     "The javadestruct%s typemap for %s is for %s but the javabody%s typemap is not. Use SWIG_JAVA_FINALIZER(%s) to keep finalize() for a custom javabody typemap.\n",
+		     derived ? "_derived" : "", c_classname, destruct_cleaner ? "SWIG_JAVA_USE_CLEANER" : "finalize()", derived ? "_derived" : "", c_classname);
+      }
       if (!destruct_methodname) {
 	Swig_error(Getfile(n), Getline(n), "No methodname attribute defined in javadestruct%s typemap for %s\n", (derived ? "_derived" : ""), proxy_class_name);
       }
@@ -1787,6 +1808,18 @@ public:
       if (*Char(destructor_call)) {
 	Printv(proxy_class_def, typemapLookup(n, "javafinalize", typemap_lookup_type, WARN_NONE), NIL);
       }
+      // Deleter used by a Cleaner, emitted even without a public destructor as the body refers to it
+      String *deleter = Copy(typemapLookup(n, "javadeleter", typemap_lookup_type, WARN_NONE));
+      if (*Char(deleter)) {
+	if (*Char(destructor_call))
+	  Replaceall(deleter, "$jnicall", destructor_call);
+	else
+	  Replaceall(deleter, "$jnicall", "throw new UnsupportedOperationException(\"C++ destructor does not have public access\")");
+	Printv(proxy_class_def, deleter, NIL);
+      } else if (body_cleaner) {
+	Swig_warning(WARN_JAVA_TYPEMAP_CLEANER_MISMATCH, Getfile(n), Getline(n), "The javabody%s typemap for %s uses a Cleaner but the javadeleter typemap is empty.\n", derived ? "_derived" : "", c_classname);
+      }
+      Delete(deleter);
       // delete method
       Printv(destruct, tm, NIL);
       if (*Char(destructor_call))
@@ -83,6 +83,93 @@ extern int AddExtern;
 #define  IMPORT_MODE     1
 #define  IMPORT_MODULE   2
 
+/* ----------------------------------------------------------------------
+ * Dispatcher timing
+ *
+ * When enabled with Dispatcher_timing_set(), the number of nodes dispatched
+ * and the real time spent handling them is accumulated for each node type.
+ * The self time excludes the time spent handling nested nodes.
+ * ---------------------------------------------------------------------- */
+
+struct DispatchTiming {
+  const char *tag;
+  int count;
+  double total;
+  double self;
+};
+
+static Hash *dispatch_timings = 0;
+static int dispatch_timing_on = 0;
+static double dispatch_nested_time = 0;
+
+void Dispatcher_timing_set(int flag) {
+  if (flag && !dispatch_timings)
+    dispatch_timings = NewHash();
+  dispatch_timing_on = flag;
+}
+
+static void dispatch_timing_delete(void *p) {
+  DispatchTiming *t = (DispatchTiming *) p;
+  free((char *) t->tag);
+  free(t);
+}
+
+static DispatchTiming *dispatch_timing(const char *tag) {
+  DOH *v = Getattr(dispatch_timings, tag);
+  if (!v) {
+    DispatchTiming *t = (DispatchTiming *) malloc(sizeof(DispatchTiming));
+    t->tag = Swig_copy_string(tag);
+    t->count = 0;
+    t->total = 0;
+    t->self = 0;
+    v = NewVoid(t, dispatch_timing_delete);
+    Setattr(dispatch_timings, tag, v);
+    Delete(v);
+  }
+  return (DispatchTiming *) Data(v);
+}
+
+static int dispatch_timing_cmp(const void *a, const void *b) {
+  const DispatchTiming *ta = *(DispatchTiming *const *) a;
+  const DispatchTiming *tb = *(DispatchTiming *const *) b;
+  if (ta->self != tb->self)
+    return ta->self < tb->self ? 1 : -1;
+  return strcmp(ta->tag, tb->tag);
+}
+
+/* ----------------------------------------------------------------------
+ * Dispatcher_timing_print()
+ *
+ * Display the times accumulated for each node type, most expensive first,
+ * either as a table or as a JSON array.
+ * ---------------------------------------------------------------------- */
+
+void Dispatcher_timing_print(File *f, int json) {
+  int n = dispatch_timings ? Len(dispatch_timings) : 0;
+  DispatchTiming **timings = (DispatchTiming **) malloc((n + 1) * sizeof(DispatchTiming *));
+  int i = 0;
+  if (dispatch_timings) {
+    for (Iterator ki = First(dispatch_timings); ki.key; ki = Next(ki))
+      timings[i++] = (DispatchTiming *) Data(ki.item);
+  }
+  qsort(timings, n, sizeof(DispatchTiming *), dispatch_timing_cmp);
+  if (json) {
+    Printf(f, "[");
+    for (i = 0; i < n; i++) {
+      DispatchTiming *t = timings[i];
+      Printf(f, "%s\n    { \"type\": \"%s\", \"count\": %d, \"wall\": %.6f, \"self\": %.6f }", i ? "," : "", t->tag, t->count, t->total, t->self);
+    }
+    Printf(f, "\n  ]");
+  } else {
+    Printf(f, "  %-22s %10s %12s %12s\n", "Node type", "Count", "Wall (s)", "Self (s)");
+    for (i = 0; i < n; i++) {
+      DispatchTiming *t = timings[i];
+      Printf(f, "  %-22s %10d %12.3f %12.3f\n", t->tag, t->count, t->total, t->self);
+    }
+  }
+  free(timings);
+}
+
 /* ----------------------------------------------------------------------
  * Dispatcher::emit_one()
  *
@@ -111,6 +198,14 @@ int Dispatcher::emit_one(Node *n) {
     Swig_warnfilter(wrn, 1);
   }
 
+  double start_time = 0;
+  double nested_time = 0;
+  if (dispatch_timing_on) {
+    start_time = Swig_wall_time();
+    nested_time = dispatch_nested_time;
+    dispatch_nested_time = 0;
+  }
+
   /* ============================================================
    * C/C++ parsing
    * ============================================================ */
@@ -183,6 +278,14 @@ int Dispatcher::emit_one(Node *n) {
     Swig_error(input_file, line_number, "Unrecognized parse tree node type '%s'\n", tag);
     ret = SWIG_ERROR;
   }
+  if (dispatch_timing_on) {
+    double elapsed = Swig_wall_time() - start_time;
+    DispatchTiming *t = dispatch_timing(tag);
+    t->count++;
+    t->total += elapsed;
+    t->self += elapsed - dispatch_nested_time;
+    dispatch_nested_time = nested_time + elapsed;
+  }
   if (wrn) {
     Swig_warnfilter(wrn, 0);
   }
@@ -2296,6 +2399,7 @@ static void addDestructor(Node *n) {
     Setattr(cn, "sym:name", symname);
     Setattr(cn, "decl", "f().");
     Setattr(cn, "parentNode", n);
+    Setattr(cn, "default_destructor", "1");
 
     Symtab *oldscope = Swig_symbol_setscope(Getattr(n, "symtab"));
     Node *nonstandard_destructor = Equal(possible_nonstandard_symname, symname) ? 0 : Swig_symbol_clookup(possible_nonstandard_symname, 0);
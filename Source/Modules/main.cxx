@@ -65,13 +65,19 @@ static const char *usage1 = (const char *) "\
      -cpperraswarn   - Treat the preprocessor #error statement as #warning (default)\n\
      -copyright      - Display copyright notices\n\
      -debug-classes  - Display information about the classes found in the interface\n\
+     -debug-file     - Display files opened and include path cache statistics\n\
      -debug-module <n>- Display module parse tree at stages 1-4, <n> is a csv list of stages\n\
+     -debug-preprocessor - Display preprocessor macro expansion statistics\n\
+     -debug-scanner  - Display scanner throughput when tokenizing the preprocessed input\n\
+     -debug-stats    - Display call statistics of the most expensive lookups and their top keys\n\
      -debug-symtabs  - Display symbol tables information\n\
      -debug-symbols  - Display target language symbols in the symbol tables\n\
      -debug-csymbols - Display C symbols in the symbol tables\n\
      -debug-lsymbols - Display target language layer symbols\n\
      -debug-tags     - Display information about the tags found in the interface\n\
      -debug-template - Display information for debugging templates\n\
+     -debug-timing   - Display time and memory used by each processing stage and node type\n\
+     -debug-timing-json <file> - Write -debug-timing information to <file> in JSON format\n\
      -debug-top <n>  - Display entire parse tree at stages 1-4, <n> is a csv list of stages\n\
      -debug-typedef  - Display information about the types and typedefs in the interface\n\
      -debug-typemap  - Display typemap debugging information\n\
@@ -110,6 +116,7 @@ static const char *usage2 = (const char *) "\
      -MMD            - Like `-MD', but omit files in SWIG library\n\
      -module <name>  - Set module name to <name>\n\
      -MT <target>    - Set the target of the rule emitted by dependency generation\n\
+     -multipass      - Run the types and allocators stages as separate passes over the tree\n\
      -nocontract     - Turn off contract checking\n\
      -nocpperraswarn - Do not treat the preprocessor #error statement as #warning\n\
      -nodefault      - Do not generate default constructors nor default destructors\n\
@@ -188,7 +195,14 @@ static int werror = 0;
 static int depend = 0;
 static int depend_only = 0;
 static int memory_debug = 0;
+static int file_debug = 0;
+static int preprocessor_debug = 0;
+static int scanner_debug = 0;
+static int timing_debug = 0;
+static int stats_debug = 0;
+static String *timing_json = 0;
 static int allkw = 0;
+static int multipass = 0;
 static DOH *cpps = 0;
 static String *dependencies_file = 0;
 static String *dependencies_target = 0;
@@ -303,6 +317,115 @@ static void configure_outdir(const String *c_wrapper_file_dir) {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * Stage timing (-debug-timing)
+ *
+ * Records the real and processor time, the number of DOH objects allocated and
+ * the peak memory use as each stage of the processing completes.
+ * ----------------------------------------------------------------------------- */
+
+struct TimingStage {
+  const char *name;
+  double wall;
+  double cpu;
+  int objects;
+  long peak_memory;
+};
+
+static TimingStage timing_stages[8];
+static int timing_nstages = 0;
+static double timing_wall = 0;
+static double timing_cpu = 0;
+static int timing_objects = 0;
+
+static void timing_begin() {
+  if (!timing_debug && !timing_json)
+    return;
+  timing_wall = Swig_wall_time();
+  timing_cpu = Swig_cpu_time();
+  timing_objects = DohMemoryAllocated();
+}
+
+static void timing_end(const char *name) {
+  if (!timing_debug && !timing_json)
+    return;
+  assert(timing_nstages < (int)(sizeof(timing_stages) / sizeof(timing_stages[0])));
+  TimingStage *t = &timing_stages[timing_nstages++];
+  t->name = name;
+  t->wall = Swig_wall_time() - timing_wall;
+  t->cpu = Swig_cpu_time() - timing_cpu;
+  t->objects = DohMemoryAllocated() - timing_objects;
+  t->peak_memory = Swig_peak_memory();
+}
+
+/* Writes s as a JSON string literal */
+static void timing_json_string(File *f, const char *s) {
+  Putc('"', f);
+  for (; *s; s++) {
+    unsigned char c = (unsigned char)*s;
+    switch (c) {
+    case '"':
+      Printf(f, "\\\"");
+      break;
+    case '\\':
+      Printf(f, "\\\\");
+      break;
+    case '\n':
+      Printf(f, "\\n");
+      break;
+    case '\r':
+      Printf(f, "\\r");
+      break;
+    case '\t':
+      Printf(f, "\\t");
+      break;
+    default:
+      if (c < 0x20)
+	Printf(f, "\\u%04x", c);
+      else
+	Putc(c, f);
+      break;
+    }
+  }
+  Putc('"', f);
+}
+
+static void timing_print(File *f, int json) {
+  TimingStage total = { "total", 0, 0, 0, 0 };
+  int i;
+  for (i = 0; i < timing_nstages; i++) {
+    total.wall += timing_stages[i].wall;
+    total.cpu += timing_stages[i].cpu;
+    total.objects += timing_stages[i].objects;
+    if (timing_stages[i].peak_memory > total.peak_memory)
+      total.peak_memory = timing_stages[i].peak_memory;
+  }
+  if (json) {
+    Printf(f, "{\n  \"version\": ");
+    timing_json_string(f, Swig_package_version());
+    Printf(f, ",\n  \"input\": ");
+    timing_json_string(f, input_file ? Char(input_file) : "");
+    Printf(f, ",\n  \"stages\": [");
+    for (i = 0; i <= timing_nstages; i++) {
+      TimingStage *t = (i < timing_nstages) ? &timing_stages[i] : &total;
+      Printf(f, "%s\n    { \"name\": \"%s\", \"wall\": %.6f, \"cpu\": %.6f, \"objects\": %d, \"peak_memory_kb\": %d }",
+	     i ? "," : "", t->name, t->wall, t->cpu, t->objects, (int)t->peak_memory);
+    }
+    Printf(f, "\n  ],\n  \"node_types\": ");
+    Dispatcher_timing_print(f, 1);
+    Printf(f, "\n}\n");
+  } else {
+    Printf(f, "Timing:\n");
+    Printf(f, "  %-22s %12s %12s %12s %16s\n", "Stage", "Wall (s)", "CPU (s)", "Objects", "Peak memory (KB)");
+    for (i = 0; i <= timing_nstages; i++) {
+      TimingStage *t = (i < timing_nstages) ? &timing_stages[i] : &total;
+      Printf(f, "  %-22s %12.3f %12.3f %12d %16d\n", t->name, t->wall, t->cpu, t->objects, (int)t->peak_memory);
+    }
+    Printf(f, "\nTarget language module (top stage) by node type:\n");
+    Dispatcher_timing_print(f, 0);
+  }
+}
+
 /* This function sets the name of the configuration file */
 void SWIG_config_file(const_String_or_char_ptr filename) {
   lang_config = NewString(filename);
@@ -817,6 +940,9 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-nocontract") == 0) {
 	Swig_mark_arg(i);
 	Swig_contract_mode_set(0);
+      } else if (strcmp(argv[i], "-multipass") == 0) {
+	Swig_mark_arg(i);
+	multipass = 1;
       } else if (strcmp(argv[i], "-browse") == 0) {
 	browse = 1;
 	Swig_mark_arg(i);
@@ -829,6 +955,31 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if ((strcmp(argv[i], "-debug-memory") == 0) || (strcmp(argv[i], "-dump_memory") == 0)) {
 	memory_debug = 1;
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-file") == 0) {
+	Swig_file_debug_set();
+	file_debug = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-preprocessor") == 0) {
+	preprocessor_debug = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-scanner") == 0) {
+	scanner_debug = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-stats") == 0) {
+	stats_debug = 1;
+	Swig_stats_set(1);
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-timing") == 0) {
+	timing_debug = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-timing-json") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  timing_json = NewString(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-Fstandard") == 0) {
 	Swig_error_msg_format(EMF_STANDARD);
 	Swig_mark_arg(i);
@@ -1021,6 +1172,7 @@ int SWIG_main(int argc, char *argv[], Language *l) {
     {
       int i;
       String *fs = NewString("");
+      timing_begin();
       FILE *df = Swig_open(input_file);
       if (!df) {
 	df = Swig_include_open(input_file);
@@ -1057,9 +1209,13 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	cpps = Swig_read_file(df);
 	fclose(df);
       }
+      timing_end("preprocess");
       if (Swig_error_count()) {
 	SWIG_exit(EXIT_FAILURE);
       }
+      if (scanner_debug) {
+	Scanner_debug_throughput(cpps);
+      }
       if (cpp_only) {
 	Printf(stdout, "%s", cpps);
 	SWIG_exit(EXIT_SUCCESS);
@@ -1132,7 +1288,9 @@ int SWIG_main(int argc, char *argv[], Language *l) {
       fflush(stdout);
     }
 
+    timing_begin();
     Node *top = Swig_cparse(cpps);
+    timing_end("parse");
 
     if (dump_top & STAGE1) {
       Printf(stdout, "debug-top stage 1\n");
@@ -1143,10 +1301,19 @@ int SWIG_main(int argc, char *argv[], Language *l) {
       Swig_print_tree(Getattr(top, "module"));
     }
 
+    /* Unless asked for separate passes, or for the parse tree in between them, the
+       allocators are run on each top level declaration right after its types are
+       processed, so that the declaration is still in the cache */
+    Dispatcher *allocators = 0;
+    if (!multipass && !((dump_top | dump_module) & STAGE2))
+      allocators = Swig_default_allocators_fused();
+
     if (Verbose) {
-      Printf(stdout, "Processing types...\n");
+      Printf(stdout, allocators ? "Processing types and C++ analysis...\n" : "Processing types...\n");
     }
-    Swig_process_types(top);
+    timing_begin();
+    Swig_process_types(top, allocators);
+    timing_end(allocators ? "types+allocators" : "types");
 
     if (dump_top & STAGE2) {
       Printf(stdout, "debug-top stage 2\n");
@@ -1157,10 +1324,16 @@ int SWIG_main(int argc, char *argv[], Language *l) {
       Swig_print_tree(Getattr(top, "module"));
     }
 
-    if (Verbose) {
-      Printf(stdout, "C++ analysis...\n");
+    if (allocators) {
+      delete allocators;
+    } else {
+      if (Verbose) {
+	Printf(stdout, "C++ analysis...\n");
+      }
+      timing_begin();
+      Swig_default_allocators(top);
+      timing_end("allocators");
     }
-    Swig_default_allocators(top);
 
     if (dump_top & STAGE3) {
       Printf(stdout, "debug-top stage 3\n");
@@ -1238,13 +1411,19 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	}
 	configure_outdir(Swig_file_dirname(Getattr(top, "outfile")));
 	if (Swig_contract_mode_get()) {
+	  timing_begin();
 	  Swig_contracts(top);
+	  timing_end("contracts");
 	}
 
 	// Check the suffix for a c/c++ file.  If so, we're going to declare everything we see as "extern"
 	ForceExtern = check_suffix(input_file);
 
+	timing_begin();
+	Dispatcher_timing_set(timing_debug || timing_json);
 	lang->top(top);
+	Dispatcher_timing_set(0);
+	timing_end("top");
 
 	if (browse) {
 	  Swig_browser(top, 0);
@@ -1273,6 +1452,23 @@ int SWIG_main(int argc, char *argv[], Language *l) {
     Swig_typemap_debug();
   if (memory_debug)
     DohMemoryDebug();
+  if (file_debug)
+    Swig_file_debug_stats();
+  if (preprocessor_debug)
+    Preprocessor_debug_stats();
+  if (stats_debug)
+    Swig_stats_print(10);
+  if (timing_debug)
+    timing_print(stdout, 0);
+  if (timing_json) {
+    File *f_timing = NewFile(timing_json, "w", 0);
+    if (!f_timing) {
+      FileErrorDisplay(timing_json);
+      SWIG_exit(EXIT_FAILURE);
+    }
+    timing_print(f_timing, 1);
+    Delete(f_timing);
+  }
 
   char *outfiles = getenv("CCACHE_OUTFILES");
   if (outfiles) {
@@ -59,7 +59,7 @@ void Wrapper_cast_dispatch_mode_set(int flag) {
  * languages ignore the first method parsed.
  * ----------------------------------------------------------------------------- */
 
-List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
+static List *overload_rank(Node *n, bool script_lang_wrapping) {
   Overloaded nodes[MAX_OVERLOAD];
   int nnodes = 0;
   Node *o = Getattr(n, "sym:overloaded");
@@ -300,6 +300,13 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
   return result;
 }
 
+List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_OVERLOAD_RANK);
+  List *result = overload_rank(n, script_lang_wrapping);
+  Swig_stats_end(SWIG_STATS_OVERLOAD_RANK, stats_start, Getattr(n, "name"), 0);
+  return result;
+}
+
 // /* -----------------------------------------------------------------------------
 //  * print_typecheck()
 //  * ----------------------------------------------------------------------------- */
@@ -32,6 +32,8 @@ static String *global_name = 0;
 static int shadow = 1;
 static int use_kw = 0;
 static int director_method_index = 0;
+static List *director_method_names = 0;
+static List *director_protected_names = 0;
 static int builtin = 0;
 
 static File *f_begin = 0;
@@ -259,6 +261,38 @@ public:
     return threads && !GetFlagAttr(n, "feature:nothread");
   }
 
+  /* ------------------------------------------------------------
+   * threads_release_gil()
+   *
+   * Whether a wrapper releases the GIL around the wrapped call.  The
+   * nogil feature of the function, or else of its class, decides and
+   * the GIL is released if it is not set.  If it is "auto", the GIL is
+   * only kept for calls too cheap to be worth releasing it for: the
+   * generated member variable accessors and the functions with a short
+   * body known to make no calls.
+   * ------------------------------------------------------------ */
+
+  int threads_release_gil(Node *n) const {
+    String *nogil = Getattr(n, "feature:nogil");
+    Node *cls = getCurrentClass();
+    if (!nogil && cls)
+      nogil = Getattr(cls, "feature:nogil");
+    if (!nogil)
+      return 1;
+    if (!Equal(nogil, "auto"))
+      return Strcmp(nogil, "0") != 0;
+
+    if ((Getattr(n, "memberget") || Getattr(n, "memberset")) && !GetFlag(n, "feature:extend"))
+      return 0;
+
+    String *code = Getattr(n, "code");
+    String *nodetype = nodeType(n);
+    if (code && Len(code) <= 256 && !Equal(nodetype, "constructor") && !Equal(nodetype, "destructor")
+	&& !Strchr(code, '(') && !Strstr(code, "goto"))
+      return 0;
+    return 1;
+  }
+
   int initialize_threads(String *f_init) {
     if (!threads) {
       return SWIG_OK;
@@ -2420,7 +2454,7 @@ public:
     if (director_method) {
       Append(f->code, "try {\n");
     } else {
-      if (allow_thread) {
+      if (allow_thread && threads_release_gil(n)) {
 	String *preaction = NewString("");
 	thread_begin_allow(n, preaction);
 	Setattr(n, "wrap:preaction", preaction);
@@ -3000,6 +3034,7 @@ public:
 	call = Swig_csuperclass_call(0, basetype, superparms);
 	Printf(w->def, "%s::%s: %s, Swig::Director(self) { \n", classname, target, call);
 	Printf(w->def, "   SWIG_DIRECTOR_RGTR((%s *)this, this); \n", basetype);
+	Append(w->def, "   swig_init_override(); \n");
 	Append(w->def, "}\n");
 	Delete(target);
 	Wrapper_print(w, f_directors);
@@ -3034,6 +3069,7 @@ public:
       Wrapper *w = NewWrapper();
       Printf(w->def, "SwigDirector_%s::SwigDirector_%s(PyObject* self) : Swig::Director(self) { \n", classname, classname);
       Printf(w->def, "   SWIG_DIRECTOR_RGTR((%s *)this, this); \n", basetype);
+      Append(w->def, "   swig_init_override(); \n");
       Append(w->def, "}\n");
       Wrapper_print(w, f_directors);
       DelWrapper(w);
@@ -3066,50 +3102,130 @@ public:
 
     if (dirprot_mode()) {
       /*
-         This implementation uses a std::map<std::string,int>.
-
-         It should be possible to rewrite it using a more elegant way,
-         like copying the Java approach for the 'override' array.
-
-         But for now, this seems to be the least intrusive way.
+         The flag of a protected method is set while it is being called in
+         Python.  The flags are indexed like the vtable, the names are only
+         compared for the flags that are set.
        */
+      int protected_methods = 0;
+      for (Iterator pi = First(director_protected_names); pi.item; pi = Next(pi))
+	if (Len(pi.item))
+	  protected_methods++;
+
       Printf(f_directors_h, "\n\n");
       Printf(f_directors_h, "/* Internal Director utilities */\n");
       Printf(f_directors_h, "public:\n");
       Printf(f_directors_h, "    bool swig_get_inner(const char* swig_protected_method_name) const {\n");
-      Printf(f_directors_h, "      std::map<std::string, bool>::const_iterator iv = swig_inner.find(swig_protected_method_name);\n");
-      Printf(f_directors_h, "      return (iv != swig_inner.end() ? iv->second : false);\n");
+      if (protected_methods) {
+	Printf(f_directors_h, "      static const char *const swig_protected_method_names[] = {");
+	for (Iterator pi = First(director_protected_names); pi.item; pi = Next(pi)) {
+	  if (Len(pi.item))
+	    Printf(f_directors_h, "\n        \"%s\",", pi.item);
+	  else
+	    Printf(f_directors_h, "\n        0,");
+	}
+	Printf(f_directors_h, "\n      };\n");
+	Printf(f_directors_h, "      if (swig_inner.none())\n");
+	Printf(f_directors_h, "        return false;\n");
+	Printf(f_directors_h, "      for (size_t i = 0; i < %d; ++i) {\n", director_method_index);
+	Printf(f_directors_h, "        if (swig_inner[i] && strcmp(swig_protected_method_names[i], swig_protected_method_name) == 0)\n");
+	Printf(f_directors_h, "          return true;\n");
+	Printf(f_directors_h, "      }\n");
+      } else {
+	Printf(f_directors_h, "      (void)swig_protected_method_name;\n");
+      }
+      Printf(f_directors_h, "      return false;\n");
       Printf(f_directors_h, "    }\n\n");
-
-      Printf(f_directors_h, "    void swig_set_inner(const char* swig_protected_method_name, bool val) const\n");
-      Printf(f_directors_h, "    { swig_inner[swig_protected_method_name] = val;}\n\n");
-      Printf(f_directors_h, "private:\n");
-      Printf(f_directors_h, "    mutable std::map<std::string, bool> swig_inner;\n");
-
+      if (protected_methods) {
+	Printf(f_directors_h, "private:\n");
+	Printf(f_directors_h, "    mutable std::bitset<%d> swig_inner;\n", director_method_index);
+      }
     }
     if (director_method_index) {
+      /* Method names, interned once at module initialization */
+      Printf(f_directors_h, "\n\n");
+      Printf(f_directors_h, "/* Method names */\n");
+      Printf(f_directors_h, "public:\n");
+      Printf(f_directors_h, "    static void swig_init_method_names() {\n");
+      Printf(f_directors_h, "      static const char *const names[] = {");
+      for (Iterator mi = First(director_method_names); mi.item; mi = Next(mi))
+	Printf(f_directors_h, "\n        \"%s\",", mi.item);
+      Printf(f_directors_h, "\n      };\n");
+      Printf(f_directors_h, "      for (size_t i = 0; i < %d; ++i)\n", director_method_index);
+      Printf(f_directors_h, "        swig_method_names[i] = swig_intern_name(names[i]);\n");
+      Printf(f_directors_h, "    }\n");
+      Printf(f_directors_h, "private:\n");
+      Printf(f_directors_h, "    static PyObject *swig_method_names[%d];\n", director_method_index);
+      Printf(f_directors, "PyObject *SwigDirector_%s::swig_method_names[%d];\n\n", classname, director_method_index);
+      Printf(f_init, "SwigDirector_%s::swig_init_method_names();\n", classname);
+
       Printf(f_directors_h, "\n\n");
       Printf(f_directors_h, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
-      Printf(f_directors_h, "/* VTable implementation */\n");
+      Printf(f_directors_h, "/* VTable implementation, flushed when the Python class is modified */\n");
+      Printf(f_directors_h, "public:\n");
       Printf(f_directors_h, "    PyObject *swig_get_method(size_t method_index, const char *method_name) const {\n");
+      Printf(f_directors_h, "      if (vtable_version != swig_self_type_version()) {\n");
+      Printf(f_directors_h, "        for (size_t i = 0; i < %d; ++i)\n", director_method_index);
+      Printf(f_directors_h, "          vtable[i] = 0;\n");
+      Printf(f_directors_h, "      }\n");
       Printf(f_directors_h, "      PyObject *method = vtable[method_index];\n");
       Printf(f_directors_h, "      if (!method) {\n");
-      Printf(f_directors_h, "        swig::SwigVar_PyObject name = SWIG_Python_str_FromChar(method_name);\n");
-      Printf(f_directors_h, "        method = PyObject_GetAttr(swig_get_self(), name);\n");
+      Printf(f_directors_h, "        method = PyObject_GetAttr(swig_get_self(), swig_method_names[method_index]);\n");
       Printf(f_directors_h, "        if (!method) {\n");
       Printf(f_directors_h, "          std::string msg = \"Method in class %s doesn't exist, undefined \";\n", classname);
       Printf(f_directors_h, "          msg += method_name;\n");
       Printf(f_directors_h, "          Swig::DirectorMethodException::raise(msg.c_str());\n");
       Printf(f_directors_h, "        }\n");
       Printf(f_directors_h, "        vtable[method_index] = method;\n");
+      Printf(f_directors_h, "        vtable_version = swig_self_type_version();\n");
       Printf(f_directors_h, "      }\n");
       Printf(f_directors_h, "      return method;\n");
       Printf(f_directors_h, "    }\n");
       Printf(f_directors_h, "private:\n");
       Printf(f_directors_h, "    mutable swig::SwigVar_PyObject vtable[%d];\n", director_method_index);
+      Printf(f_directors_h, "    mutable unsigned int vtable_version;\n");
       Printf(f_directors_h, "#endif\n\n");
     }
 
+    /* Override array, recomputed when the Python class or one of its bases is modified */
+    Printf(f_directors_h, "\n\n");
+    Printf(f_directors_h, "/* Overridden method lookup, redone when the Python class is modified */\n");
+    Printf(f_directors_h, "private:\n");
+    Printf(f_directors_h, "    void swig_init_override() {\n");
+    if (director_method_index) {
+      SwigType *p_real_classname = Copy(Getattr(n, "name"));
+      SwigType_add_pointer(p_real_classname);
+      String *mangle = SwigType_manglestr(p_real_classname);
+      Printf(f_directors_h, "      swig_override_version = 0;\n");
+      Printf(f_directors_h, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
+      Printf(f_directors_h, "      vtable_version = 0;\n");
+      Printf(f_directors_h, "#endif\n");
+      Printf(f_directors_h, "    }\n");
+      Printf(f_directors_h, "    bool swig_overrides(size_t method_index) const {\n");
+      Printf(f_directors_h, "      static PyObject *klass_methods[%d];\n", director_method_index);
+      Printf(f_directors_h, "      SwigPyClientData *data = (SwigPyClientData *)SWIGTYPE%s->clientdata;\n", mangle);
+      Printf(f_directors_h, "      PyObject *klass = data ? (data->pytype ? (PyObject *)data->pytype : data->klass) : 0;\n");
+      Printf(f_directors_h, "      bool overridden = true;\n");
+      Printf(f_directors_h, "      SWIG_PYTHON_THREAD_BEGIN_BLOCK;\n");
+      Printf(f_directors_h, "      unsigned int version = swig_self_type_version_assigned(swig_method_names[method_index]);\n");
+      Printf(f_directors_h, "      if (version) {\n");
+      Printf(f_directors_h, "        if (version != swig_override_version) {\n");
+      Printf(f_directors_h, "          for (size_t i = 0; i < %d; ++i)\n", director_method_index);
+      Printf(f_directors_h, "            swig_override[i] = swig_overrides_method(klass, swig_method_names[i], &klass_methods[i]);\n");
+      Printf(f_directors_h, "          swig_override_version = version;\n");
+      Printf(f_directors_h, "        }\n");
+      Printf(f_directors_h, "        overridden = swig_override[method_index] || swig_instance_overrides(swig_method_names[method_index]);\n");
+      Printf(f_directors_h, "      }\n");
+      Printf(f_directors_h, "      SWIG_PYTHON_THREAD_END_BLOCK;\n");
+      Printf(f_directors_h, "      return overridden;\n");
+      Printf(f_directors_h, "    }\n");
+      Printf(f_directors_h, "    mutable bool swig_override[%d];\n", director_method_index);
+      Printf(f_directors_h, "    mutable unsigned int swig_override_version;\n");
+      Delete(mangle);
+      Delete(p_real_classname);
+    } else {
+      Printf(f_directors_h, "    }\n");
+    }
+
     Printf(f_directors_h, "};\n\n");
     return Language::classDirectorEnd(n);
   }
@@ -4521,6 +4637,10 @@ public:
  * --------------------------------------------------------------- */
 int PYTHON::classDirectorMethods(Node *n) {
   director_method_index = 0;
+  Delete(director_method_names);
+  director_method_names = NewList();
+  Delete(director_protected_names);
+  director_protected_names = NewList();
   return Language::classDirectorMethods(n);
 }
 
@@ -4656,6 +4776,17 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
     String *arglist = NewString("");
     String *parse_args = NewString("");
 
+    /* call the C++ method directly if the Python class does not override it */
+    if (!pure_virtual) {
+      String *super_call = Swig_method_call(super, l);
+      Printf(w->code, "if (!swig_overrides(%d)) {\n", director_method_index);
+      Printf(w->code, "%s%s;\n", is_void ? "" : "return ", super_call);
+      if (is_void)
+	Printf(w->code, "return;\n");
+      Printf(w->code, "}\n");
+      Delete(super_call);
+    }
+
     Swig_director_parms_fixup(l);
 
     /* remove the wrapper 'w' since it was producing spurious temps */
@@ -4795,6 +4926,8 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
 
     /* add the method name as a PyString */
     String *pyname = Getattr(n, "sym:name");
+    Append(director_method_names, pyname);
+    Append(director_protected_names, dirprot_mode() && !is_public(n) ? name : "");
 
     int allow_thread = threads_enable(n);
 
@@ -4808,18 +4941,26 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
 
     /* pass the method call on to the Python object */
     if (dirprot_mode() && !is_public(n)) {
-      Printf(w->code, "swig_set_inner(\"%s\", true);\n", name);
+      Printf(w->code, "swig_inner.set(%d);\n", director_method_index);
     }
 
 
     Append(w->code, "if (!swig_get_self()) {\n");
     Printf(w->code, "  Swig::DirectorException::raise(\"'self' uninitialized, maybe you forgot to call %s.__init__.\");\n", classname);
     Append(w->code, "}\n");
+    int method_index = director_method_index++;
     Append(w->code, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
-    Printf(w->code, "const size_t swig_method_index = %d;\n", director_method_index++);
+    Printf(w->code, "const size_t swig_method_index = %d;\n", method_index);
     Printf(w->code, "const char * const swig_method_name = \"%s\";\n", pyname);
 
     Append(w->code, "PyObject* method = swig_get_method(swig_method_index, swig_method_name);\n");
+    if (!use_parse) {
+      /* the arguments are all PyObjects, pass them on the stack */
+      Append(w->code, "#if PY_VERSION_HEX >= 0x03090000\n");
+      Printf(w->code, "PyObject *swig_args[] = {0%s};\n", arglist);
+      Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_Vectorcall(method, swig_args + 1, %d | PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);\n", Swig_cresult_name(), Len(parse_args));
+      Append(w->code, "#else\n");
+    }
     if (Len(parse_args) > 0) {
       if (use_parse || !modernargs) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallFunction(method, (char *)\"(%s)\" %s);\n", Swig_cresult_name(), parse_args, arglist);
@@ -4834,26 +4975,35 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallFunction(method, NULL, NULL);\n", Swig_cresult_name());
       }
     }
+    if (!use_parse)
+      Append(w->code, "#endif\n");
     Append(w->code, "#else\n");
+    if (!use_parse) {
+      Append(w->code, "#if PY_VERSION_HEX >= 0x03090000\n");
+      Printf(w->code, "PyObject *swig_args[] = {0, swig_get_self()%s};\n", arglist);
+      Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_VectorcallMethod(swig_method_names[%d], swig_args + 1, %d | PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);\n",
+	     Swig_cresult_name(), method_index, Len(parse_args) + 1);
+      Append(w->code, "#else\n");
+    }
     if (Len(parse_args) > 0) {
       if (use_parse || !modernargs) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethod(swig_get_self(), (char *)\"%s\", (char *)\"(%s)\" %s);\n", Swig_cresult_name(), pyname, parse_args, arglist);
       } else {
-	Printf(w->code, "swig::SwigVar_PyObject swig_method_name = SWIG_Python_str_FromChar((char *)\"%s\");\n", pyname);
-	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), (PyObject *) swig_method_name %s, NULL);\n", Swig_cresult_name(), arglist);
+	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), swig_method_names[%d] %s, NULL);\n", Swig_cresult_name(), method_index, arglist);
       }
     } else {
       if (!modernargs) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethod(swig_get_self(), (char *) \"%s\", NULL);\n", Swig_cresult_name(), pyname);
       } else {
-	Printf(w->code, "swig::SwigVar_PyObject swig_method_name = SWIG_Python_str_FromChar((char *)\"%s\");\n", pyname);
-	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), (PyObject *) swig_method_name, NULL);\n", Swig_cresult_name());
+	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), swig_method_names[%d], NULL);\n", Swig_cresult_name(), method_index);
       }
     }
+    if (!use_parse)
+      Append(w->code, "#endif\n");
     Append(w->code, "#endif\n");
 
     if (dirprot_mode() && !is_public(n))
-      Printf(w->code, "swig_set_inner(\"%s\", false);\n", name);
+      Printf(w->code, "swig_inner.reset(%d);\n", method_index);
 
     /* exception handling */
     tm = Swig_typemap_lookup("director:except", n, Swig_cresult_name(), 0);
@@ -387,6 +387,9 @@ void Wrapper_naturalvar_mode_set(int);
 
 void clean_overloaded(Node *n);
 
+void Dispatcher_timing_set(int flag);
+void Dispatcher_timing_print(File *f, int json);
+
 extern "C" {
   const char *Swig_to_string(DOH *object, int count = -1);
   const char *Swig_to_string_with_location(DOH *object, int count = -1);
@@ -404,6 +407,7 @@ int Swig_contract_mode_get();
 
 void Swig_browser(Node *n, int);
 void Swig_default_allocators(Node *n);
-void Swig_process_types(Node *n);
+Dispatcher *Swig_default_allocators_fused();
+void Swig_process_types(Node *n, Dispatcher *allocators = 0);
 
 #endif
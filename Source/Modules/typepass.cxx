@@ -39,8 +39,10 @@ class TypePass:private Dispatcher {
   String *nssymname;
   Hash *classhash;
   List *normalize;
+  Dispatcher *allocators;
+  int fused_depth;
 
-  TypePass() {
+  TypePass(Dispatcher *allocators_pass = 0):allocators(allocators_pass), fused_depth(0) {
   }
 
   /* Normalize a type. Replaces type with fully qualified version */
@@ -322,6 +324,27 @@ class TypePass:private Dispatcher {
     Delete(allbases);
   }
 
+  /* ------------------------------------------------------------
+   * emit_one()
+   *
+   * When fused with the allocators pass, each declaration at the top
+   * level (a whole class or namespace included) is handed on to the
+   * allocators as soon as its types have been processed.
+   * ------------------------------------------------------------ */
+
+  virtual int emit_one(Node *n) {
+    if (!allocators || fused_depth > 0)
+      return Dispatcher::emit_one(n);
+    String *tag = nodeType(n);
+    if (Equal(tag, "include") || Equal(tag, "import") || Equal(tag, "extern"))
+      return Dispatcher::emit_one(n);
+    fused_depth++;
+    int ret = Dispatcher::emit_one(n);
+    fused_depth--;
+    allocators->emit_one(n);
+    return ret;
+  }
+
   /* ------------------------------------------------------------
    * top()
    * ------------------------------------------------------------ */
@@ -1241,14 +1264,14 @@ class TypePass:private Dispatcher {
   }
 
 public:
-  static void pass(Node *n) {
-    TypePass t;
+  static void pass(Node *n, Dispatcher *allocators) {
+    TypePass t(allocators);
     t.top(n);
   }
 };
 
-void Swig_process_types(Node *n) {
+void Swig_process_types(Node *n, Dispatcher *allocators) {
   if (!n)
     return;
-  TypePass::pass(n);
+  TypePass::pass(n, allocators);
 }
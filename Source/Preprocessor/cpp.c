@@ -38,6 +38,21 @@ static int macro_level = 0;
 static int macro_start_line = 0;
 static const String * macro_start_file = 0;
 
+/* Macro expansion cache, see expand_macro_cached() */
+static Hash *macro_cache = 0;		/* "name(args)" -> expansion */
+static Hash *macro_cache_ids = 0;	/* Identifiers the cached expansions depend on */
+static int macro_cache_depth = 0;	/* Non-zero when computing a cacheable expansion */
+static int macro_cache_silent = 0;	/* Non-zero while diagnostics are silenced */
+static int macro_impure = 0;		/* Set when an expansion depends on its context */
+static int macro_expanding = 0;		/* Number of macros currently being expanded */
+
+static int pp_expansions = 0;
+static int pp_cache_hits = 0;
+static int pp_cache_stores = 0;
+static int pp_cache_uncacheable = 0;
+static int pp_cache_flushes = 0;
+static int pp_scanned = 0;
+
 /* Test a character to see if it starts an identifier */
 #define isidentifier(c) ((isalpha(c)) || (c == '_') || (c == '$'))
 
@@ -45,6 +60,7 @@ static const String * macro_start_file = 0;
 #define isidchar(c) ((isalnum(c)) || (c == '_') || (c == '$'))
 
 static DOH *Preprocessor_replace(DOH *);
+static void macro_cache_invalidate(String *name);
 
 /* Skip whitespace */
 static void skip_whitespace(String *s, String *out) {
@@ -203,6 +219,9 @@ void Preprocessor_init(void) {
 
   id_scan = NewScanner();
 
+  macro_cache = NewHash();
+  macro_cache_ids = NewHash();
+
 }
 
 void Preprocessor_delete(void) {
@@ -248,6 +267,10 @@ void Preprocessor_delete(void) {
   DelScanner(id_scan);
 
   Delete(dependencies);
+  Delete(macro_cache);
+  Delete(macro_cache_ids);
+  macro_cache = 0;
+  macro_cache_ids = 0;
 
   Delete(Swig_add_directory(0));
 }
@@ -527,6 +550,7 @@ Hash *Preprocessor_define(const_String_or_char_ptr _str, int swigmacro) {
       goto macro_error;
     }
   } else {
+    macro_cache_invalidate(macroname);
     Setattr(symbols, macroname, macro);
     Delete(macro);
   }
@@ -556,6 +580,11 @@ void Preprocessor_undef(const_String_or_char_ptr str) {
   Hash *symbols;
   assert(cpp);
   symbols = Getattr(cpp, kpp_symbols);
+  if (Getattr(symbols, str)) {
+    String *name = NewString(str);
+    macro_cache_invalidate(name);
+    Delete(name);
+  }
   Delattr(symbols, str);
 }
 
@@ -937,15 +966,18 @@ static String *expand_macro(String *name, List *args, String *line_file) {
 
   /* Expand this macro even further */
   Setattr(macro, kpp_expanded, "1");
+  macro_expanding++;
 
   e = Preprocessor_replace(ns);
 
+  macro_expanding--;
   Delattr(macro, kpp_expanded);
   Delete(ns);
 
   if (Getattr(macro, kpp_swigmacro)) {
     String *g;
     String *f = NewStringEmpty();
+    macro_impure = 1;
     Seek(e, 0, SEEK_SET);
     copy_location(macro, e);
     g = Preprocessor_parse(e);
@@ -975,6 +1007,120 @@ static String *expand_macro(String *name, List *args, String *line_file) {
   return e;
 }
 
+/* -----------------------------------------------------------------------------
+ * Macro expansion cache
+ *
+ * The expansion of a macro with a given set of arguments is remembered so that
+ * repeated uses do not have to be expanded again.  Only expansions which do not
+ * depend on the context they are expanded in are cached, that is, only C macros
+ * (not %define macros, whose expansion is preprocessed again), which are not
+ * expanded within another macro and do not use __LINE__, __FILE__, defined or
+ * #if.  Expansions which issue an error or warning, or which are computed while
+ * diagnostics are silenced, are not cached either, as a cache hit would lose the
+ * diagnostics.  The name of each cached macro and the identifiers looked up while
+ * computing its expansion are recorded and the cache is flushed whenever one of
+ * them is defined or undefined.
+ * ----------------------------------------------------------------------------- */
+
+/* Records an identifier that a cached expansion depends on */
+static void macro_cache_id(String *id) {
+  if (!Getattr(macro_cache_ids, id)) {
+    String *key = Copy(id);
+    Setattr(macro_cache_ids, key, key);
+    Delete(key);
+  }
+}
+
+/* Flushes the cache if a cached expansion depends on the given macro name */
+static void macro_cache_invalidate(String *name) {
+  if (macro_cache_ids && Getattr(macro_cache_ids, name)) {
+    Clear(macro_cache);
+    Clear(macro_cache_ids);
+    pp_cache_flushes++;
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * expand_macro_cached()
+ *
+ * Wrapper around expand_macro() that looks up and populates the macro cache.
+ * ----------------------------------------------------------------------------- */
+
+static String *expand_macro_cached(String *name, List *args, String *line_file) {
+  String *key, *e;
+  Hash *macro;
+  int saved_impure, errors, warnings;
+
+  pp_expansions++;
+  macro = Getattr(Getattr(cpp, kpp_symbols), name);
+  if (!macro || macro_expanding || expand_defined_operator || Getattr(macro, kpp_swigmacro)) {
+    pp_cache_uncacheable++;
+    return expand_macro(name, args, line_file);
+  }
+
+  key = NewString(name);
+  if (args) {
+    int i, lenargs = Len(args);
+    Putc('(', key);
+    for (i = 0; i < lenargs; i++) {
+      if (i)
+	Putc(',', key);
+      Append(key, Getitem(args, i));
+    }
+    Putc(')', key);
+  }
+  e = Getattr(macro_cache, key);
+  if (e) {
+    pp_cache_hits++;
+    Delete(key);
+    return Copy(e);
+  }
+
+  saved_impure = macro_impure;
+  macro_impure = 0;
+  errors = Swig_error_count();
+  warnings = Swig_warn_count();
+  macro_cache_depth++;
+  e = expand_macro(name, args, line_file);
+  macro_cache_depth--;
+  if (e && !macro_impure && !macro_cache_silent && errors == Swig_error_count() && warnings == Swig_warn_count()) {
+    macro_cache_id(name);
+    Setattr(macro_cache, key, e);
+    pp_cache_stores++;
+  } else {
+    pp_cache_uncacheable++;
+  }
+  macro_impure |= saved_impure;
+  Delete(key);
+  return e;
+}
+
+/* Appends len characters to the string s keeping track of the line number */
+static void append_chars(String *s, const char *c, int len) {
+  int i, line;
+  if (len <= 0)
+    return;
+  line = Getline(s);
+  for (i = 0; i < len; i++) {
+    if (c[i] == '\n')
+      line++;
+  }
+  Write(s, c, len);
+  Setline(s, line);
+}
+
+/* Moves the position of s forward to pos counting lines in the same way as Getc */
+static void advance_to(String *s, const char *base, int pos) {
+  int sp = (int)Tell(s);
+  int line = Getline(s);
+  for (; sp < pos; sp++) {
+    if (base[sp] == '\n')
+      line++;
+  }
+  Seek(s, pos, SEEK_SET);
+  Setline(s, line);
+}
+
 /* -----------------------------------------------------------------------------
  * DOH *Preprocessor_replace(DOH *s)
  *
@@ -982,13 +1128,18 @@ static String *expand_macro(String *name, List *args, String *line_file) {
  * substitutions applied.   This function works by walking down s and looking
  * for identifiers.   When found, a check is made to see if they are macros
  * which are then expanded.
+ *
+ * The characters of s are scanned directly and runs of text which do not need
+ * replacing are copied to the result in one go.  The position of s is only
+ * updated when an identifier needs to be handled as a macro or special symbol.
  * ----------------------------------------------------------------------------- */
 
-/* #define SWIG_PUT_BUFF  */
-
 static DOH *Preprocessor_replace(DOH *s) {
   DOH *ns, *symbols, *m;
-  int c, i, state = 0;
+  int c, i;
+  int pos, len, start, idstart;
+  int at_end = 0;
+  char *base;
   String *id = NewStringEmpty();
 
   assert(cpp);
@@ -998,218 +1149,195 @@ static DOH *Preprocessor_replace(DOH *s) {
   copy_location(s, ns);
   Seek(s, 0, SEEK_SET);
 
+  base = Char(s);
+  len = Len(s);
+  pp_scanned += len;
+  pos = 0;
+  start = 0;			/* Start of the text to be copied unchanged */
+
   /* Try to locate identifiers in s and replace them with macro replacements */
-  while ((c = Getc(s)) != EOF) {
-    switch (state) {
-    case 0:
-      if (isidentifier(c)) {
-	Clear(id);
-	Putc(c, id);
-	state = 4;
-      } else if (c == '%') {
-	Clear(id);
-	Putc(c, id);
-	state = 2;
-      } else if (c == '#') {
-	Clear(id);
-	Putc(c, id);
-	state = 4;
-      } else if (c == '\"') {
-	Putc(c, ns);
-	skip_tochar(s, '\"', ns);
-      } else if (c == '\'') {
-	Putc(c, ns);
-	skip_tochar(s, '\'', ns);
-      } else if (c == '/') {
-	Putc(c, ns);
-	state = 10;
-      } else if (c == '\\') {
-	Putc(c, ns);
-	c = Getc(s);
-	if (c == '\n') {
-	  Putc(c, ns);
-	} else {
-	  Ungetc(c, s);
-	}
-      } else if (c == '\n') {
-	Putc(c, ns);
-	expand_defined_operator = 0;
-      } else {
-	Putc(c, ns);
-      }
-      break;
-    case 2:
-      /* Found '%#' */
-      if (c == '#') {
-	Putc(c, id);
-	state = 4;
-      } else {
-	Ungetc(c, s);
-	state = 4;
+  while (pos < len) {
+    c = (unsigned char) base[pos];
+    if (isidentifier(c) || (c == '%') || (c == '#')) {
+      /* An identifier, or '%' and '%#' or '#' followed by an identifier */
+      append_chars(ns, base + start, pos - start);
+      idstart = pos++;
+      if ((c == '%') && (pos < len) && (base[pos] == '#'))
+	pos++;
+      while ((pos < len) && isidchar((unsigned char) base[pos]))
+	pos++;
+      Clear(id);
+      Write(id, base + idstart, pos - idstart);
+      if (macro_cache_depth)
+	macro_cache_id(id);
+      start = pos;
+      if (pos >= len) {
+	at_end = 1;
+	break;
       }
-      break;
-    case 4:			/* An identifier */
-      if (isidchar(c)) {
-	Putc(c, id);
-	state = 4;
-      } else {
-	/* We found the end of a valid identifier */
-	Ungetc(c, s);
-	/* See if this is the special "defined" operator */
-       	if (Equal(kpp_defined, id)) {
-	  if (expand_defined_operator) {
-	    int lenargs = 0;
-	    DOH *args = 0;
-	    /* See whether or not a parenthesis has been used */
-	    skip_whitespace(s, 0);
-	    c = Getc(s);
-	    if (c == '(') {
-	      Ungetc(c, s);
-	      args = find_args(s, 0, kpp_defined);
-	    } else if (isidchar(c)) {
-	      DOH *arg = NewStringEmpty();
-	      args = NewList();
-	      Putc(c, arg);
-	      while (((c = Getc(s)) != EOF)) {
-		if (!isidchar(c)) {
-		  Ungetc(c, s);
-		  break;
-		}
-		Putc(c, arg);
-	      }
-	      if (Len(arg))
-		Append(args, arg);
-	      Delete(arg);
-	    } else {
-	      Seek(s, -1, SEEK_CUR);
-	    }
-	    lenargs = Len(args);
-	    if ((!args) || (!lenargs)) {
-	      /* This is not a defined() operator. */
-	      Append(ns, id);
-	      state = 0;
-	      break;
-	    }
-	    for (i = 0; i < lenargs; i++) {
-	      DOH *o = Getitem(args, i);
-	      if (!Getattr(symbols, o)) {
+
+      /* We found the end of a valid identifier */
+      /* See if this is the special "defined" operator */
+      if (Equal(kpp_defined, id)) {
+	if (expand_defined_operator) {
+	  int lenargs = 0;
+	  DOH *args = 0;
+	  macro_impure = 1;
+	  advance_to(s, base, pos);
+	  /* See whether or not a parenthesis has been used */
+	  skip_whitespace(s, 0);
+	  c = Getc(s);
+	  if (c == '(') {
+	    Ungetc(c, s);
+	    args = find_args(s, 0, kpp_defined);
+	  } else if (isidchar(c)) {
+	    DOH *arg = NewStringEmpty();
+	    args = NewList();
+	    Putc(c, arg);
+	    while (((c = Getc(s)) != EOF)) {
+	      if (!isidchar(c)) {
+		Ungetc(c, s);
 		break;
 	      }
+	      Putc(c, arg);
 	    }
-	    if (i < lenargs)
-	      Putc('0', ns);
-	    else
-	      Putc('1', ns);
-	    Delete(args);
+	    if (Len(arg))
+	      Append(args, arg);
+	    Delete(arg);
 	  } else {
+	    Seek(s, -1, SEEK_CUR);
+	  }
+	  start = pos = (int)Tell(s);
+	  lenargs = Len(args);
+	  if ((!args) || (!lenargs)) {
+	    /* This is not a defined() operator. */
 	    Append(ns, id);
+	    continue;
 	  }
-	  state = 0;
-	  break;
-	} else if (Equal(kpp_LINE, id)) {
-	  Printf(ns, "%d", macro_level > 0 ? macro_start_line : Getline(s));
-	  state = 0;
-	  break;
-	} else if (Equal(kpp_FILE, id)) {
-	  String *fn = Copy(macro_level > 0 ? macro_start_file : Getfile(s));
-	  Replaceall(fn, "\\", "\\\\");
-	  Printf(ns, "\"%s\"", fn);
-	  Delete(fn);
-	  state = 0;
-	  break;
-	} else if (Equal(kpp_hash_if, id) || Equal(kpp_hash_elif, id)) {
-	  expand_defined_operator = 1;
-	  Append(ns, id);
-	  /*
-	} else if (Equal("%#if", id) || Equal("%#ifdef", id)) {
-	  Swig_warning(998, Getfile(s), Getline(s), "Found: %s preprocessor directive.\n", id);
-	  Append(ns, id);
-	} else if (Equal("#ifdef", id) || Equal("#ifndef", id)) {
-	  Swig_warning(998, Getfile(s), Getline(s), "The %s preprocessor directive does not work in macros, try #if instead.\n", id);
-	  Append(ns, id);
-	  */
-	} else if ((m = Getattr(symbols, id))) {
-	  /* See if the macro is defined in the preprocessor symbol table */
-	  DOH *args = 0;
-	  DOH *e;
-	  int macro_additional_lines = 0;
-	  /* See if the macro expects arguments */
-	  if (Getattr(m, kpp_args)) {
-	    /* Yep.  We need to go find the arguments and do a substitution */
-	    int line = Getline(s);
-	    args = find_args(s, 1, id);
-	    macro_additional_lines = Getline(s) - line;
-	    assert(macro_additional_lines >= 0);
-	    if (!Len(args)) {
-	      Delete(args);
-	      args = 0;
+	  for (i = 0; i < lenargs; i++) {
+	    DOH *o = Getitem(args, i);
+	    if (!Getattr(symbols, o)) {
+	      break;
 	    }
-	  } else {
-	    args = 0;
 	  }
-	  e = expand_macro(id, args, s);
-	  if (e) {
-	    Append(ns, e);
-	  }
-	  while (macro_additional_lines--) {
-	    Putc('\n', ns);
-	  }
-	  Delete(e);
+	  if (i < lenargs)
+	    Putc('0', ns);
+	  else
+	    Putc('1', ns);
 	  Delete(args);
 	} else {
 	  Append(ns, id);
 	}
-	state = 0;
+      } else if (Equal(kpp_LINE, id)) {
+	macro_impure = 1;
+	advance_to(s, base, pos);
+	Printf(ns, "%d", macro_level > 0 ? macro_start_line : Getline(s));
+      } else if (Equal(kpp_FILE, id)) {
+	String *fn = Copy(macro_level > 0 ? macro_start_file : Getfile(s));
+	macro_impure = 1;
+	Replaceall(fn, "\\", "\\\\");
+	Printf(ns, "\"%s\"", fn);
+	Delete(fn);
+      } else if (Equal(kpp_hash_if, id) || Equal(kpp_hash_elif, id)) {
+	macro_impure = 1;
+	expand_defined_operator = 1;
+	Append(ns, id);
+	/*
+      } else if (Equal("%#if", id) || Equal("%#ifdef", id)) {
+	Swig_warning(998, Getfile(s), Getline(s), "Found: %s preprocessor directive.\n", id);
+	Append(ns, id);
+      } else if (Equal("#ifdef", id) || Equal("#ifndef", id)) {
+	Swig_warning(998, Getfile(s), Getline(s), "The %s preprocessor directive does not work in macros, try #if instead.\n", id);
+	Append(ns, id);
+	*/
+      } else if ((m = Getattr(symbols, id))) {
+	/* See if the macro is defined in the preprocessor symbol table */
+	DOH *args = 0;
+	DOH *e;
+	int macro_additional_lines = 0;
+	advance_to(s, base, pos);
+	/* See if the macro expects arguments */
+	if (Getattr(m, kpp_args)) {
+	  /* Yep.  We need to go find the arguments and do a substitution */
+	  int line = Getline(s);
+	  args = find_args(s, 1, id);
+	  macro_additional_lines = Getline(s) - line;
+	  assert(macro_additional_lines >= 0);
+	  if (!Len(args)) {
+	    Delete(args);
+	    args = 0;
+	  }
+	} else {
+	  args = 0;
+	}
+	e = expand_macro_cached(id, args, s);
+	if (e) {
+	  Append(ns, e);
+	}
+	while (macro_additional_lines--) {
+	  Putc('\n', ns);
+	}
+	Delete(e);
+	Delete(args);
+	start = pos = (int)Tell(s);
+      } else {
+	Append(ns, id);
       }
-      break;
-    case 10:
-      if (c == '/')
-	state = 11;
-      else if (c == '*')
-	state = 12;
-      else {
-	Ungetc(c, s);
-	state = 0;
-	break;
+    } else if ((c == '\"') || (c == '\'')) {
+      /* Copy a string or character literal */
+      pos++;
+      while (pos < len) {
+	int cc = base[pos++];
+	if (cc == c)
+	  break;
+	if ((cc == '\\') && (pos < len))
+	  pos++;
       }
-      Putc(c, ns);
-      break;
-    case 11:
-      /* in C++ comment */
-      Putc(c, ns);
-      if (c == '\n') {
-	expand_defined_operator = 0;
-	state = 0;
+    } else if (c == '/') {
+      pos++;
+      if ((pos < len) && (base[pos] == '/')) {
+	/* in C++ comment */
+	while ((pos < len) && (base[pos] != '\n'))
+	  pos++;
+	if (pos < len) {
+	  pos++;
+	  expand_defined_operator = 0;
+	}
+      } else if ((pos < len) && (base[pos] == '*')) {
+	/* in C comment */
+	pos++;
+	while (pos < len) {
+	  if ((base[pos] == '*') && (pos + 1 < len) && (base[pos + 1] == '/')) {
+	    pos += 2;
+	    break;
+	  }
+	  pos++;
+	}
       }
-      break;
-    case 12:
-      /* in C comment */
-      Putc(c, ns);
-      if (c == '*')
-	state = 13;
-      break;
-    case 13:
-      Putc(c, ns);
-      if (c == '/')
-	state = 0;
-      else if (c != '*')
-	state = 12;
-      break;
-    default:
-      state = 0;
-      break;
+    } else if (c == '\\') {
+      pos++;
+      if ((pos < len) && (base[pos] == '\n'))
+	pos++;
+    } else {
+      if (c == '\n')
+	expand_defined_operator = 0;
+      pos++;
     }
   }
+  append_chars(ns, base + start, pos - start);
+  advance_to(s, base, len);
 
   /* Identifier at the end */
-  if (state == 2 || state == 4) {
+  if (at_end) {
     /* See if this is the special "defined" operator */
     if (Equal(kpp_defined, id)) {
       Swig_error(Getfile(s), Getline(s), "No arguments given to defined()\n");
     } else if (Equal(kpp_LINE, id)) {
+      macro_impure = 1;
       Printf(ns, "%d", macro_level > 0 ? macro_start_line : Getline(s));
     } else if (Equal(kpp_FILE, id)) {
       String *fn = Copy(macro_level > 0 ? macro_start_file : Getfile(s));
+      macro_impure = 1;
       Replaceall(fn, "\\", "\\\\");
       Printf(ns, "\"%s\"", fn);
       Delete(fn);
@@ -1220,7 +1348,7 @@ static DOH *Preprocessor_replace(DOH *s) {
       /*      if (Getattr(m,"args")) {
          Swig_error(Getfile(id),Getline(id),"Macro arguments expected.\n");
          } */
-      e = expand_macro(id, 0, s);
+      e = expand_macro_cached(id, 0, s);
       if (e)
 	Append(ns, e);
       Delete(e);
@@ -1233,6 +1361,20 @@ static DOH *Preprocessor_replace(DOH *s) {
 }
 
 
+/* -----------------------------------------------------------------------------
+ * Preprocessor_debug_stats()
+ *
+ * Displays statistics about macro expansion and the macro expansion cache.
+ * ----------------------------------------------------------------------------- */
+
+void Preprocessor_debug_stats(void) {
+  Printf(stdout, "Preprocessor: %d characters scanned for macros\n", pp_scanned);
+  Printf(stdout, "Preprocessor: %d macro expansions, %d from cache, %d cached, %d not cacheable\n",
+	 pp_expansions, pp_cache_hits, pp_cache_stores, pp_cache_uncacheable);
+  Printf(stdout, "Preprocessor: %d cache flushes, %d expansions currently cached\n",
+	 pp_cache_flushes, macro_cache ? Len(macro_cache) : 0);
+}
+
 /* -----------------------------------------------------------------------------
  * int checkpp_id(DOH *s)
  *
@@ -1550,7 +1692,9 @@ String *Preprocessor_parse(String *s) {
 	    copy_location(m, v);
 	    if (Len(v)) {
 	      Swig_error_silent(1);
+	      macro_cache_silent++;
 	      v1 = Preprocessor_replace(v);
+	      macro_cache_silent--;
 	      Swig_error_silent(0);
 	      /*              Printf(stdout,"checking '%s'\n", v1); */
 	      if (!checkpp_id(v1)) {
@@ -16,6 +16,13 @@
 char cvsroot_include_c[] = "$Id$";
 
 #include "swig.h"
+#include <errno.h>
+#include <ctype.h>
+
+#if defined(HAVE_DIRENT_H) && !defined(_WIN32)
+#include <dirent.h>
+#define SWIG_FILE_DIRCACHE 1
+#endif
 
 static List   *directories = 0;	        /* List of include directories */
 static String *lastpath = 0;	        /* Last file that was included */
@@ -23,6 +30,20 @@ static List   *pdirectories = 0;        /* List of pushed directories  */
 static int     dopush = 1;		/* Whether to push directories */
 static int file_debug = 0;
 
+static List   *search_paths[2] = { 0, 0 }; /* Cached search paths (normal, system) */
+static Hash   *dircache = 0;		/* Directory listings: directory -> Hash of entries */
+static String *dirunlisted = 0;		/* Marker for directories that could not be listed */
+static int     opens_avoided = 0;	/* fopen calls skipped due to the directory cache */
+static int     dirs_listed = 0;		/* Number of directories read into the cache */
+
+/* Discard the cached search paths whenever the directory lists change */
+static void search_path_reset(void) {
+  Delete(search_paths[0]);
+  Delete(search_paths[1]);
+  search_paths[0] = 0;
+  search_paths[1] = 0;
+}
+
 /* This functions determine whether to push/pop dirs in the preprocessor */
 void Swig_set_push_dir(int push) {
   dopush = push;
@@ -47,6 +68,7 @@ List *Swig_add_directory(const_String_or_char_ptr dirname) {
     adirname = NewString(dirname);
     Append(directories,adirname);
     Delete(adirname);
+    search_path_reset();
   }
   return directories;
 }
@@ -69,6 +91,7 @@ void Swig_push_directory(const_String_or_char_ptr dirname) {
   assert(pdirname);
   Insert(pdirectories,0,pdirname);
   Delete(pdirname);
+  search_path_reset();
 }
 
 /* -----------------------------------------------------------------------------
@@ -84,6 +107,7 @@ void Swig_pop_directory(void) {
   if (!pdirectories)
     return;
   Delitem(pdirectories, 0);
+  search_path_reset();
 }
 
 /* -----------------------------------------------------------------------------
@@ -151,6 +175,85 @@ List *Swig_search_path() {
   return Swig_search_path_any(0);
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_file_missing()
+ *
+ * Uses a cache of directory listings to determine whether the file path, which
+ * is a search path directory joined with a file name, definitely does not exist.
+ * Each directory is read just once, so the many failed fopen calls made when
+ * searching a long include path are replaced by in-memory lookups.  Returns 0
+ * if the file might exist, in which case it must be opened to find out.
+ * ----------------------------------------------------------------------------- */
+
+#ifdef SWIG_FILE_DIRCACHE
+static String *file_name_lower(const char *name) {
+  String *lower = NewStringEmpty();
+  for (; *name; name++)
+    Putc(tolower((unsigned char)*name), lower);
+  return lower;
+}
+#endif
+
+static int Swig_file_missing(String *path) {
+#ifdef SWIG_FILE_DIRCACHE
+  String *dirname;
+  Hash *entries;
+  char *cpath = Char(path);
+  char *base = strrchr(cpath, *SWIG_FILE_DELIMITER);
+
+  if (!base)
+    return 0;
+  dirname = NewStringWithSize(cpath, (int)(base - cpath) + 1);
+  base++;
+
+  if (!dircache) {
+    dircache = NewHash();
+    dirunlisted = NewString("");
+  }
+  entries = Getattr(dircache, dirname);
+  if (!entries) {
+    DIR *dir = opendir(Char(dirname));
+    if (dir) {
+      struct dirent *ent;
+      entries = NewHash();
+      while ((ent = readdir(dir))) {
+	String *lower = file_name_lower(ent->d_name);
+	Setattr(entries, ent->d_name, dirunlisted);
+	Setattr(entries, lower, dirunlisted);
+	Delete(lower);
+      }
+      closedir(dir);
+      dirs_listed++;
+    } else if (errno == ENOENT || errno == ENOTDIR) {
+      /* Nothing can be found under a non-existent directory */
+      entries = NewHash();
+    } else {
+      /* Unreadable, eg no read permission, so always fall back to fopen */
+      entries = dirunlisted;
+      DohIncref(entries);
+    }
+    Setattr(dircache, dirname, entries);
+    Delete(entries);
+  }
+  Delete(dirname);
+
+  /* The file system may be case insensitive, as on macOS, so an entry which
+     only differs in case also has to be opened to find out */
+  if (entries != dirunlisted && !Getattr(entries, base)) {
+    String *lower = file_name_lower(base);
+    int missing = !Getattr(entries, lower);
+    Delete(lower);
+    if (missing) {
+      opens_avoided++;
+      return 1;
+    }
+  }
+#else
+  (void)path;
+#endif
+  return 0;
+}
+
 
 
 /* -----------------------------------------------------------------------------
@@ -179,16 +282,21 @@ static FILE *Swig_open_file(const_String_or_char_ptr name, int sysfile, int use_
   }
   f = fopen(Char(filename), "r");
   if (!f && use_include_path) {
-    spath = Swig_search_path_any(sysfile);
+    sysfile = sysfile ? 1 : 0;
+    if (!search_paths[sysfile])
+      search_paths[sysfile] = Swig_search_path_any(sysfile);
+    spath = search_paths[sysfile];
     ilen = Len(spath);
     for (i = 0; i < ilen; i++) {
       Clear(filename);
-      Printf(filename, "%s%s", Getitem(spath, i), cname);
+      Append(filename, Getitem(spath, i));
+      Append(filename, cname);
+      if (Swig_file_missing(filename))
+	continue;
       f = fopen(Char(filename), "r");
       if (f)
 	break;
     }
-    Delete(spath);
   }
   if (f) {
     Delete(lastpath);
@@ -212,17 +320,37 @@ FILE *Swig_open(const_String_or_char_ptr name) {
 /* -----------------------------------------------------------------------------
  * Swig_read_file()
  * 
- * Reads data from an open FILE * and returns it as a string.
+ * Reads data from an open FILE * and returns it as a string.  The remaining
+ * size of the file is determined up front so that the contents can be read
+ * with a single fread into a buffer and appended to a string of the right size.
+ * Streams that cannot be positioned are read in chunks.
  * ----------------------------------------------------------------------------- */
 
 String *Swig_read_file(FILE *f) {
   int len;
   char buffer[4096];
   String *str = NewStringEmpty();
+  long start = ftell(f);
+  long size = -1;
 
   assert(str);
-  while (fgets(buffer, 4095, f)) {
-    Append(str, buffer);
+  if (start >= 0 && fseek(f, 0, SEEK_END) == 0) {
+    size = ftell(f) - start;
+    if (fseek(f, start, SEEK_SET) != 0)
+      size = -1;
+  }
+  if (size >= 0) {
+    char *data = (char *)malloc((size_t)size + 1);
+    size_t nread;
+    assert(data);
+    nread = fread(data, 1, (size_t)size, f);
+    data[nread] = 0;
+    Append(str, data);
+    free(data);
+  } else {
+    while (fgets(buffer, 4095, f)) {
+      Append(str, buffer);
+    }
   }
   len = Len(str);
   /* Add a newline if not present on last line -- the preprocessor seems to 
@@ -397,3 +525,20 @@ char *Swig_file_dirname(const_String_or_char_ptr filename) {
 void Swig_file_debug_set() {
   file_debug = 1;
 }
+
+/* -----------------------------------------------------------------------------
+ * Swig_file_debug_stats()
+ *
+ * Display statistics about the include directory cache.  Listing a directory
+ * costs about three system calls (open, read entries, close), whereas every
+ * avoided fopen saves a failed open, so the cache does not always pay off.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_file_debug_stats(void) {
+  int saved = opens_avoided - 3 * dirs_listed;
+  Printf(stdout, "File cache: %d directories listed, %d failed opens avoided, ", dirs_listed, opens_avoided);
+  if (saved >= 0)
+    Printf(stdout, "%d system calls saved\n", saved);
+  else
+    Printf(stdout, "%d extra system calls\n", -saved);
+}
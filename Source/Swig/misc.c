@@ -19,6 +19,13 @@ char cvsroot_misc_c[] = "$Id$";
 #include <limits.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <time.h>
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
 
 #ifdef _WIN32
 #include <direct.h>
@@ -1242,6 +1249,48 @@ String *Swig_pcre_version(void) {
 
 #endif
 
+/* -----------------------------------------------------------------------------
+ * Swig_wall_time()
+ * Swig_cpu_time()
+ *
+ * Elapsed real time and processor time in seconds, measured from an arbitrary
+ * starting point.  Only the difference between two calls is meaningful.
+ * ----------------------------------------------------------------------------- */
+
+double Swig_wall_time(void) {
+#if defined(HAVE_GETTIMEOFDAY)
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+#else
+  return (double) time(0);
+#endif
+}
+
+double Swig_cpu_time(void) {
+  return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_peak_memory()
+ *
+ * Peak resident set size of the process in kilobytes or 0 if not available.
+ * ----------------------------------------------------------------------------- */
+
+long Swig_peak_memory(void) {
+#if defined(HAVE_GETRUSAGE)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return (long) usage.ru_maxrss / 1024;	/* bytes on Mac OS X */
+#else
+    return (long) usage.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_init()
  *
@@ -557,6 +557,114 @@ DOH *Swig_name_object_get(Hash *namehash, String *prefix, String *name, SwigType
   return rn;
 }
 
+/* -----------------------------------------------------------------------------
+ * Feature index
+ *
+ * Most declarations have no features other than global ones.  The index holds
+ * the last name component (without any template parameters) of each name with
+ * features, and each class with class-generic features ("Class::").  If the
+ * last component of a declaration name is not in the index, none of the
+ * qualified names built by features_lookup() can be in the features hash.
+ * Names are only ever added to the features hash, by Swig_feature_set() and
+ * Swig_name_object_inherit(), which keep the index up to date.  The index is
+ * rebuilt should the size of the features hash not match.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *features_indexed = 0;
+static int features_indexed_len = -1;
+static Hash *features_index_names = 0;
+static Hash *features_index_classes = 0;
+static String *features_index_key = 0;
+
+/* Finds the part of the first len characters of s used as the index key */
+static int features_index_name(const char *s, int len, const char **start) {
+  int i;
+  int level = 0;
+  int begin = 0;
+  int end;
+  for (i = 0; i < len; i++) {
+    if (s[i] == '<' || s[i] == '(') {
+      level++;
+    } else if ((s[i] == '>' || s[i] == ')') && level > 0) {
+      level--;
+    } else if (level == 0 && s[i] == ':' && i + 1 < len && s[i + 1] == ':') {
+      begin = i + 2;
+      i++;
+    }
+  }
+  for (i = begin; i + 8 <= len; i++) {
+    if (strncmp(s + i, "operator", 8) == 0) {
+      *start = "operator";
+      return 8;
+    }
+  }
+  end = begin;
+  while (end < len && s[end] != '<' && s[end] != '(')
+    end++;
+  *start = s + begin;
+  return end - begin;
+}
+
+/* Adds a name in the features hash to the index */
+static void features_index_add_key(const String *key) {
+  char *k = Char(key);
+  int len = (int)strlen(k);
+  const char *start;
+  int n = features_index_name(k, len, &start);
+  String *ikey = NewStringWithSize(start, n);
+  Setattr(features_index_names, ikey, "1");
+  Delete(ikey);
+  if (len > 2 && strcmp(k + len - 2, "::") == 0) {
+    ikey = NewStringWithSize(k, len - 2);
+    Setattr(features_index_classes, ikey, "1");
+    Delete(ikey);
+  }
+}
+
+/* Records a name added to a hash, only the indexed features hash is of interest */
+static void features_index_add(Hash *features, const String *key) {
+  if (features == features_indexed && features_indexed_len >= 0) {
+    features_index_add_key(key);
+    features_indexed_len = Len(features);
+  }
+}
+
+static void features_index_update(Hash *features) {
+  Iterator ki;
+  if (features == features_indexed && Len(features) == features_indexed_len)
+    return;
+  Delete(features_index_names);
+  Delete(features_index_classes);
+  features_index_names = NewHash();
+  features_index_classes = NewHash();
+  if (!features_index_key)
+    features_index_key = NewStringEmpty();
+  for (ki = First(features); ki.key; ki = Next(ki))
+    features_index_add_key(ki.key);
+  features_indexed = features;
+  features_indexed_len = Len(features);
+}
+
+/* Checks if a feature may exist for name or its template prefix */
+static int features_index_has_name(const String *name) {
+  char *s = Char(name);
+  char *t = strstr(s, "<(");
+  const char *start;
+  int n = features_index_name(s, (int)strlen(s), &start);
+  Clear(features_index_key);
+  Write(features_index_key, start, n);
+  if (Getattr(features_index_names, features_index_key))
+    return 1;
+  if (t) {
+    n = features_index_name(s, (int)(t - s), &start);
+    Clear(features_index_key);
+    Write(features_index_key, start, n);
+    if (Getattr(features_index_names, features_index_key))
+      return 1;
+  }
+  return 0;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_name_object_inherit()
  *
@@ -615,6 +723,7 @@ void Swig_name_object_inherit(Hash *namehash, String *base, String *derived) {
   if (derh) {
     for (ki = First(derh); ki.key; ki = Next(ki)) {
       Setattr(namehash, ki.key, ki.item);
+      features_index_add(namehash, ki.key);
     }
   }
 
@@ -662,7 +771,7 @@ void features_get(Hash *features, const String *tname, SwigType *decl, SwigType
   }
 }
 
-void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
+static void features_lookup(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
   char *ncdecl = 0;
   String *rdecl = 0;
   String *rname = 0;
@@ -709,7 +818,15 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
 
   /* Global features */
   features_get(features, "", 0, 0, node);
-  if (name) {
+  features_index_update(features);
+  if (name && !features_index_has_name(name)) {
+    /* Only a class-generic feature can match */
+    if (prefix && Len(prefix) && Getattr(features_index_classes, prefix)) {
+      String *tname = NewStringf("%s::", prefix);
+      features_get(features, tname, decl, ncdecl, node);
+      Delete(tname);
+    }
+  } else if (name) {
     String *tname = NewStringEmpty();
     /* add features for 'root' template */
     String *dname = SwigType_istemplate_templateprefix(name);
@@ -767,6 +884,12 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
     Delete(rdecl);
 }
 
+void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_FEATURES_GET);
+  features_lookup(features, prefix, name, decl, node);
+  Swig_stats_end(SWIG_STATS_FEATURES_GET, stats_start, name ? name : "", decl);
+}
+
 
 /* -----------------------------------------------------------------------------
  * Swig_feature_set()
@@ -788,6 +911,7 @@ void Swig_feature_set(Hash *features, const_String_or_char_ptr name, SwigType *d
   if (!n) {
     n = NewHash();
     Setattr(features, name, n);
+    features_index_add(features, name);
     Delete(n);
   }
   if (!decl) {
@@ -1514,6 +1638,7 @@ static String *apply_rename(String *newname, int fullname, String *prefix, Strin
  * ----------------------------------------------------------------------------- */
 
 String *Swig_name_make(Node *n, String *prefix, const_String_or_char_ptr cname, SwigType *decl, String *oldname) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_NAME_MAKE);
   String *nname = 0;
   String *result = 0;
   String *name = NewString(cname);
@@ -1634,6 +1759,7 @@ String *Swig_name_make(Node *n, String *prefix, const_String_or_char_ptr cname,
   Printf(stdout, "Swig_name_make: result  '%s' '%s'\n", cname, result);
 #endif
 
+  Swig_stats_end(SWIG_STATS_NAME_MAKE, stats_start, cname, decl);
   return result;
 }
 
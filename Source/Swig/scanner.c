@@ -18,6 +18,7 @@ char cvsroot_scanner_c[] = "$Id$";
 
 #include "swig.h"
 #include <ctype.h>
+#include <time.h>
 
 extern String *cparse_file;
 extern int cparse_line;
@@ -25,9 +26,15 @@ extern int cparse_cplusplus;
 extern int cparse_start_line;
 
 struct Scanner {
-  String *text;			/* Current token value */
+  String *text;			/* Current token value (see text_flush()) */
   List   *scanobjs;		/* Objects being scanned */
   String *str;			/* Current object being scanned */
+  char   *buf;			/* Characters of str */
+  int     pos;			/* Position of the next character in buf */
+  int     len;			/* Length of buf */
+  int     spos;			/* Position in buf at which the line number of str is valid */
+  int     tstart;		/* Start of the token characters in buf not yet in text */
+  int     tlinepos;		/* Position in buf from which newlines update the line number of text */
   char   *idstart;		/* Optional identifier start characters */
   int     nexttoken;		/* Next token to be returned */
   int     start_line;		/* Starting line of certain declarations */
@@ -64,11 +71,97 @@ Scanner *NewScanner(void) {
   s->scanobjs = NewList();
   s->text = NewStringEmpty();
   s->str = 0;
+  s->buf = 0;
+  s->pos = 0;
+  s->len = 0;
+  s->spos = 0;
+  s->tstart = 0;
+  s->tlinepos = 0;
   s->error = 0;
   s->freeze_line = 0;
   return s;
 }
 
+/* -----------------------------------------------------------------------------
+ * Token text
+ *
+ * The characters of a token are not copied into the text string one at a time.
+ * Instead the text is held as the text string followed by the pending characters
+ * buf[tstart..pos) of the string being scanned.  The pending characters are
+ * copied into the text string in one go when the text is requested, and before
+ * the text string is modified or the string being scanned changes.
+ * ----------------------------------------------------------------------------- */
+
+static void text_flush(Scanner *s) {
+  if (s->pos > s->tstart) {
+    int i = (s->tlinepos > s->tstart) ? s->tlinepos : s->tstart;
+    int line = Getline(s->text);
+    for (; i < s->pos; i++) {
+      if (s->buf[i] == '\n')
+	line++;
+    }
+    Write(s->text, s->buf + s->tstart, s->pos - s->tstart);
+    Setline(s->text, line);
+  }
+  s->tstart = s->pos;
+}
+
+static void text_clear(Scanner *s) {
+  Clear(s->text);
+  s->tstart = s->pos;
+}
+
+static void text_setline(Scanner *s, int line) {
+  Setline(s->text, line);
+  s->tlinepos = s->pos;
+}
+
+static void text_delete_last(Scanner *s) {
+  text_flush(s);
+  Delitem(s->text, DOH_END);
+}
+
+static int text_len(Scanner *s) {
+  return Len(s->text) + s->pos - s->tstart;
+}
+
+static int text_equal(Scanner *s, const char *str) {
+  int n = s->pos - s->tstart;
+  if (Len(s->text) == 0)
+    return ((int)strlen(str) == n) && (strncmp(s->buf + s->tstart, str, n) == 0);
+  text_flush(s);
+  return Strcmp(s->text, str) == 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * str_load()
+ * str_line()
+ *
+ * Start scanning the characters of the current string directly from its buffer,
+ * and return the line number of the current string at the scanning position.
+ * ----------------------------------------------------------------------------- */
+
+static void str_load(Scanner *s) {
+  s->buf = Char(s->str);
+  s->len = Len(s->str);
+  s->pos = (int)Tell(s->str);
+  s->spos = s->pos;
+  s->tstart = s->pos;
+  s->tlinepos = s->pos;
+}
+
+static int str_line(Scanner *s) {
+  if (s->pos > s->spos) {
+    int line = Getline(s->str);
+    for (; s->spos < s->pos; s->spos++) {
+      if (s->buf[s->spos] == '\n')
+	line++;
+    }
+    Setline(s->str, line);
+  }
+  return Getline(s->str);
+}
+
 /* -----------------------------------------------------------------------------
  * DelScanner()
  *
@@ -99,6 +192,8 @@ void Scanner_clear(Scanner * s) {
   Clear(s->scanobjs);
   Delete(s->error);
   s->str = 0;
+  s->buf = 0;
+  s->pos = s->len = s->spos = s->tstart = s->tlinepos = 0;
   s->error = 0;
   s->line = 1;
   s->nexttoken = -1;
@@ -117,12 +212,15 @@ void Scanner_push(Scanner * s, String *txt) {
   assert(s && txt);
   Push(s->scanobjs, txt);
   if (s->str) {
+    text_flush(s);
+    Seek(s->str, s->pos, SEEK_SET);
     Setline(s->str,s->line);
     Delete(s->str);
   }
   s->str = txt;
   DohIncref(s->str);
   s->line = Getline(txt);
+  str_load(s);
 }
 
 /* -----------------------------------------------------------------------------
@@ -136,8 +234,9 @@ void Scanner_pushtoken(Scanner * s, int nt, const_String_or_char_ptr val) {
   assert(s);
   assert((nt >= 0) && (nt < SWIG_MAXTOKENS));
   s->nexttoken = nt;
+  text_flush(s);
   if ( Char(val) != Char(s->text) ) {
-    Clear(s->text);
+    text_clear(s);
     Append(s->text,val);
   }
 }
@@ -149,6 +248,7 @@ void Scanner_pushtoken(Scanner * s, int nt, const_String_or_char_ptr val) {
  * ----------------------------------------------------------------------------- */
 
 void Scanner_set_location(Scanner * s, String *file, int line) {
+  s->spos = s->pos;
   Setline(s->str, line);
   Setfile(s->str, file);
   s->line = line;
@@ -197,14 +297,18 @@ void Scanner_idstart(Scanner * s, const char *id) {
  * nextchar()
  * 
  * Returns the next character from the scanner or 0 if end of the string.
+ * The character becomes part of the token text.
  * ----------------------------------------------------------------------------- */
 static char nextchar(Scanner * s) {
   int nc;
   if (!s->str)
     return 0;
-  while ((nc = Getc(s->str)) == EOF) {
+  while (s->pos >= s->len) {
+    text_flush(s);
     Delete(s->str);
     s->str = 0;
+    s->buf = 0;
+    s->pos = s->len = s->spos = s->tstart = s->tlinepos = 0;
     Delitem(s->scanobjs, 0);
     if (Len(s->scanobjs) == 0)
       return 0;
@@ -212,11 +316,12 @@ static char nextchar(Scanner * s) {
     if (s->str) {
       s->line = Getline(s->str);
       DohIncref(s->str);
+      str_load(s);
     }
   }
+  nc = (unsigned char) s->buf[s->pos++];
   if ((nc == '\n') && (!s->freeze_line)) 
     s->line++;
-  Putc(nc,s->text);
   return (char)nc;
 }
 
@@ -263,18 +368,36 @@ static void freeze_line(Scanner *s, int val) {
  * Retract n characters
  * ----------------------------------------------------------------------------- */
 static void retract(Scanner * s, int n) {
-  int i, l;
-  char *str;
+  int i;
 
-  str = Char(s->text);
-  l = Len(s->text);
-  assert(n <= l);
+  assert(n <= text_len(s));
   for (i = 0; i < n; i++) {
-    if (str[l - 1] == '\n') {
+    int c;
+    if (s->pos > s->tstart) {
+      c = s->buf[s->pos - 1];
+      if (s->pos <= s->tlinepos) {
+	s->tlinepos = s->pos - 1;
+	if (c == '\n')
+	  Setline(s->text, Getline(s->text) - 1);
+      }
+    } else {
+      char *str = Char(s->text);
+      c = str[Len(s->text) - 1];
+      Delitem(s->text, DOH_END);
+    }
+    if (c == '\n') {
       if (!s->freeze_line) s->line--;
     }
-    Seek(s->str, -1, SEEK_CUR);
-    Delitem(s->text, DOH_END);
+    if (s->pos > 0) {
+      s->pos--;
+      if (s->pos < s->spos) {
+	s->spos = s->pos;
+	if (s->buf[s->pos] == '\n')
+	  Setline(s->str, Getline(s->str) - 1);
+      }
+    }
+    if (s->tstart > s->pos)
+      s->tstart = s->pos;
   }
 }
 
@@ -296,77 +419,77 @@ static void get_escape(Scanner *s) {
     switch (state) {
     case 0:
       if (c == 'n') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\n");
 	return;
       }
       if (c == 'r') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\r");
 	return;
       }
       if (c == 't') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\t");
 	return;
       }
       if (c == 'a') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\a");
 	return;
       }
       if (c == 'b') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\b");
 	return;
       }
       if (c == 'f') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\f");
 	return;
       }
       if (c == '\\') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\\");
 	return;
       }
       if (c == 'v') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\v");
 	return;
       }
       if (c == 'e') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\033");
 	return;
       }
       if (c == '\'') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text,"\'");
 	return;
       }
       if (c == '\"') {
-	Delitem(s->text, DOH_END);	
+	text_delete_last(s);	
 	Append(s->text,"\"");
 	return;
       }
       if (c == '\n') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return;
       }
       if (isdigit(c)) {
 	state = 10;
 	result = (c - '0');
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
       } else if (c == 'x') {
 	state = 20;
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
       } else {
 	char tmp[3];
 	tmp[0] = '\\';
 	tmp[1] = (char)c;
 	tmp[2] = 0;
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	Append(s->text, tmp);
 	return;
       }
@@ -374,15 +497,17 @@ static void get_escape(Scanner *s) {
     case 10:
       if (!isdigit(c)) {
 	retract(s,1);
+	text_flush(s);
 	Putc((char)result,s->text);
 	return;
       }
       result = (result << 3) + (c - '0');
-      Delitem(s->text, DOH_END);
+      text_delete_last(s);
       break;
     case 20:
       if (!isxdigit(c)) {
 	retract(s,1);
+	text_flush(s);
 	Putc((char)result, s->text);
 	return;
       }
@@ -390,7 +515,7 @@ static void get_escape(Scanner *s) {
 	result = (result << 4) + (c - '0');
       else
 	result = (result << 4) + (10 + tolower(c) - 'a');
-      Delitem(s->text, DOH_END);
+      text_delete_last(s);
       break;
     }
   }
@@ -408,7 +533,7 @@ static int look(Scanner * s) {
   int c = 0;
 
   state = 0;
-  Clear(s->text);
+  text_clear(s);
   s->start_line = s->line;
   Setfile(s->text, Getfile(s->str));
   while (1) {
@@ -424,7 +549,7 @@ static int look(Scanner * s) {
       } else if (!isspace(c)) {
 	retract(s, 1);
 	state = 1000;
-	Clear(s->text);
+	text_clear(s);
 	Setline(s->text, s->line);
 	Setfile(s->text, Getfile(s->str));
       }
@@ -502,7 +627,7 @@ static int look(Scanner * s) {
       else if (c == '\"') {
 	state = 2;		/* Possibly a string */
 	s->start_line = s->line;
-	Clear(s->text);
+	text_clear(s);
       }
 
       else if (c == ':')
@@ -511,11 +636,11 @@ static int look(Scanner * s) {
 	state = 83;		/* An octal or hex value */
       else if (c == '\'') {
 	s->start_line = s->line;
-	Clear(s->text);
+	text_clear(s);
 	state = 9;		/* A character constant */
       } else if (c == '`') {
 	s->start_line = s->line;
-	Clear(s->text);
+	text_clear(s);
 	state = 900;
       }
 
@@ -532,14 +657,14 @@ static int look(Scanner * s) {
 	return (0);
       if (c == '/') {
 	state = 10;		/* C++ style comment */
-	Clear(s->text);
-	Setline(s->text, Getline(s->str));
+	text_clear(s);
+	Setline(s->text, str_line(s));
 	Setfile(s->text, Getfile(s->str));
 	Append(s->text, "//");
       } else if (c == '*') {
 	state = 11;		/* C style comment */
-	Clear(s->text);
-	Setline(s->text, Getline(s->str));
+	text_clear(s);
+	Setline(s->text, str_line(s));
 	Setfile(s->text, Getfile(s->str));
 	Append(s->text, "/*");
       } else if (c == '=') {
@@ -592,10 +717,10 @@ static int look(Scanner * s) {
 	return SWIG_TOKEN_ERROR;
       }
       if (c == '\"') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return SWIG_TOKEN_STRING;
       } else if (c == '\\') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	get_escape(s);
       } else
 	state = 2;
@@ -654,8 +779,8 @@ static int look(Scanner * s) {
 	return SWIG_TOKEN_PERCENT;
       if (c == '{') {
 	state = 40;		/* Include block */
-	Clear(s->text);
-	Setline(s->text, Getline(s->str));
+	text_clear(s);
+	Setline(s->text, str_line(s));
 	Setfile(s->text, Getfile(s->str));
 	s->start_line = s->line;
       } else if (s->idstart && strchr(s->idstart, '%') &&
@@ -683,8 +808,8 @@ static int look(Scanner * s) {
 	return 0;
       }
       if (c == '}') {
-	Delitem(s->text, DOH_END);
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
+	text_delete_last(s);
 	Seek(s->text,0,SEEK_SET);
 	return SWIG_TOKEN_CODEBLOCK;
       } else {
@@ -752,9 +877,9 @@ static int look(Scanner * s) {
 
     case 71:			/* Identifier or true/false */
       if (cparse_cplusplus) {
-	if (Strcmp(s->text, "true") == 0)
+	if (text_equal(s, "true"))
 	  return SWIG_TOKEN_BOOL;
-	else if (Strcmp(s->text, "false") == 0)
+	else if (text_equal(s, "false"))
 	  return SWIG_TOKEN_BOOL;
 	}
       return SWIG_TOKEN_ID;
@@ -767,7 +892,7 @@ static int look(Scanner * s) {
 	state = 7;
       } else {
 	retract(s,1);
-	if (Len(s->text) == 1) return SWIG_TOKEN_DOLLAR;
+	if (text_len(s) == 1) return SWIG_TOKEN_DOLLAR;
 	state = 71;
       }
       break;
@@ -780,7 +905,7 @@ static int look(Scanner * s) {
       } else if ((c == 'e') || (c == 'E')) {
 	state = 82;
       } else if ((c == 'f') || (c == 'F')) {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return SWIG_TOKEN_FLOAT;
       } else if (isdigit(c)) {
 	state = 8;
@@ -801,10 +926,10 @@ static int look(Scanner * s) {
       else if ((c == 'e') || (c == 'E'))
 	state = 820;
       else if ((c == 'f') || (c == 'F')) {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return SWIG_TOKEN_FLOAT;
       } else if ((c == 'l') || (c == 'L')) {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return SWIG_TOKEN_DOUBLE;
       } else {
 	retract(s, 1);
@@ -894,10 +1019,10 @@ static int look(Scanner * s) {
       if (isdigit(c))
 	state = 86;
       else if ((c == 'f') || (c == 'F')) {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return SWIG_TOKEN_FLOAT;
       } else if ((c == 'l') || (c == 'L')) {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return SWIG_TOKEN_DOUBLE;
       } else {
 	retract(s, 1);
@@ -962,10 +1087,10 @@ static int look(Scanner * s) {
 	return SWIG_TOKEN_ERROR;
       }
       if (c == '\'') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return (SWIG_TOKEN_CHAR);
       } else if (c == '\\') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	get_escape(s);
       }
       break;
@@ -1077,7 +1202,7 @@ static int look(Scanner * s) {
 	return SWIG_TOKEN_ERROR;
       }
       if (c == '`') {
-	Delitem(s->text, DOH_END);
+	text_delete_last(s);
 	return (SWIG_TOKEN_RSTRING);
       }
       break;
@@ -1105,9 +1230,9 @@ int Scanner_token(Scanner * s) {
   s->start_line = 0;
   t = look(s);
   if (!s->start_line) {
-    Setline(s->text,s->line);
+    text_setline(s,s->line);
   } else {
-    Setline(s->text,s->start_line);
+    text_setline(s,s->start_line);
   }
   return t;
 }
@@ -1119,6 +1244,7 @@ int Scanner_token(Scanner * s) {
  * ----------------------------------------------------------------------------- */
 
 String *Scanner_text(Scanner * s) {
+  text_flush(s);
   return s->text;
 }
 
@@ -1131,7 +1257,7 @@ String *Scanner_text(Scanner * s) {
 void Scanner_skip_line(Scanner * s) {
   char c;
   int done = 0;
-  Clear(s->text);
+  text_clear(s);
   Setfile(s->text, Getfile(s->str));
   Setline(s->text, s->line);
   while (!done) {
@@ -1160,7 +1286,7 @@ int Scanner_skip_balanced(Scanner * s, int startchar, int endchar) {
   char temp[2] = { 0, 0 };
   String *locator = 0;
   temp[0] = (char) startchar;
-  Clear(s->text);
+  text_clear(s);
   Setfile(s->text, Getfile(s->str));
   Setline(s->text, s->line);
 
@@ -1381,3 +1507,45 @@ void Swig_cparse_follow_locators(int v) {
 }
 
 
+
+/* -----------------------------------------------------------------------------
+ * Scanner_debug_throughput()
+ *
+ * Tokenizes text repeatedly for a fraction of a second, fetching the text of
+ * identifiers and numbers as the parser does, and displays the throughput.
+ * ----------------------------------------------------------------------------- */
+
+void Scanner_debug_throughput(String *text) {
+  Scanner *scan = NewScanner();
+  clock_t start = clock();
+  clock_t elapsed;
+  int tokens = 0;
+  int passes = 0;
+  double seconds;
+  double bytes;
+
+  Scanner_idstart(scan, "%");
+  do {
+    String *str = NewString(text);
+    int tok;
+    Seek(str, 0, SEEK_SET);
+    Setline(str, 1);
+    Setfile(str, Getfile(text));
+    Scanner_clear(scan);
+    Scanner_push(scan, str);
+    while ((tok = Scanner_token(scan)) > 0) {
+      if ((tok == SWIG_TOKEN_ID) || ((tok >= SWIG_TOKEN_FLOAT) && (tok <= SWIG_TOKEN_ULONG)))
+	(void)Scanner_text(scan);
+      tokens++;
+    }
+    Delete(str);
+    passes++;
+    elapsed = clock() - start;
+  } while (elapsed < CLOCKS_PER_SEC / 4);
+  DelScanner(scan);
+
+  seconds = (double) elapsed / CLOCKS_PER_SEC;
+  bytes = (double) Len(text) * passes;
+  Printf(stderr, "Scanner: %d tokens, %d bytes per pass, %d passes in %.3f seconds\n", tokens / passes, Len(text), passes, seconds);
+  Printf(stderr, "Scanner: %.0f tokens/s, %.2f MB/s\n", tokens / seconds, bytes / (seconds * 1024.0 * 1024.0));
+}
@@ -0,0 +1,176 @@
+/* -----------------------------------------------------------------------------
+ * This file is part of SWIG, which is licensed as a whole under version 3
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * stats.c
+ *
+ * Call statistics for the functions that dominate the time taken to process
+ * an interface.  The calls are always counted.  The time taken and the
+ * arguments (keys) responsible are only recorded when enabled by the
+ * -debug-stats option.
+ * ----------------------------------------------------------------------------- */
+
+char cvsroot_stats_c[] = "$Id$";
+
+#include "swig.h"
+
+typedef struct {
+  unsigned long calls;
+  double time;
+} StatsCount;
+
+static const char *stats_names[SWIG_STATS_MAX] = {
+  "typemap_search",
+  "Swig_symbol_clookup",
+  "SwigType_typedef_resolve",
+  "Swig_features_get",
+  "Swig_name_make",
+  "Swig_overload_rank",
+  "Swig_cparse_template_expand"
+};
+
+static StatsCount stats[SWIG_STATS_MAX];
+static Hash *stats_keys[SWIG_STATS_MAX];
+static int stats_on = 0;
+
+/* -----------------------------------------------------------------------------
+ * Swig_stats_set()
+ *
+ * Turn on recording of the time taken and keys, including the Getattr and
+ * Setattr attribute names.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_stats_set(int flag) {
+  int i;
+  for (i = 0; i < SWIG_STATS_MAX; i++) {
+    if (flag && !stats_keys[i])
+      stats_keys[i] = NewHash();
+  }
+  stats_on = flag;
+  DohStatsKeys(flag);
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_stats_begin()
+ * Swig_stats_end()
+ *
+ * Bracket a call of one of the functions in SwigStats.  The key identifies what
+ * the call was for, subkey qualifies it further and may be null.
+ * ----------------------------------------------------------------------------- */
+
+double Swig_stats_begin(SwigStats which) {
+  stats[which].calls++;
+  return stats_on ? Swig_wall_time() : 0;
+}
+
+void Swig_stats_end(SwigStats which, double start, const_String_or_char_ptr key, const_String_or_char_ptr subkey) {
+  double elapsed;
+  String *k;
+  DOH *v;
+  StatsCount *count;
+
+  if (!stats_on)
+    return;
+  elapsed = Swig_wall_time() - start;
+  stats[which].time += elapsed;
+
+  /* Keep the bookkeeping below out of the Getattr/Setattr key counts */
+  DohStatsKeys(0);
+  k = subkey ? NewStringf("%s (%s)", key, subkey) : NewStringf("%s", key);
+  v = Getattr(stats_keys[which], k);
+  if (!v) {
+    count = (StatsCount *) malloc(sizeof(StatsCount));
+    count->calls = 0;
+    count->time = 0;
+    v = NewVoid(count, free);
+    Setattr(stats_keys[which], k, v);
+    Delete(v);
+  }
+  count = (StatsCount *) Data(v);
+  count->calls++;
+  count->time += elapsed;
+  Delete(k);
+  DohStatsKeys(1);
+}
+
+/* -----------------------------------------------------------------------------
+ * stats_print_keys()
+ *
+ * Display the n most expensive keys in a hash of StatsCount (timed) or of
+ * unsigned long call counts.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+  String *key;
+  unsigned long calls;
+  double time;
+} StatsKey;
+
+static int stats_key_cmp(const void *a, const void *b) {
+  const StatsKey *ka = (const StatsKey *) a;
+  const StatsKey *kb = (const StatsKey *) b;
+  if (ka->time != kb->time)
+    return ka->time < kb->time ? 1 : -1;
+  if (ka->calls != kb->calls)
+    return ka->calls < kb->calls ? 1 : -1;
+  return Strcmp(ka->key, kb->key);
+}
+
+static void stats_print_keys(Hash *keys, int timed, int n) {
+  int len = keys ? Len(keys) : 0;
+  StatsKey *sorted;
+  Iterator ki;
+  int i = 0;
+
+  if (len == 0)
+    return;
+  sorted = (StatsKey *) malloc(len * sizeof(StatsKey));
+  for (ki = First(keys); ki.key; ki = Next(ki)) {
+    sorted[i].key = ki.key;
+    if (timed) {
+      StatsCount *count = (StatsCount *) Data(ki.item);
+      sorted[i].calls = count->calls;
+      sorted[i].time = count->time;
+    } else {
+      sorted[i].calls = *(unsigned long *) Data(ki.item);
+      sorted[i].time = 0;
+    }
+    i++;
+  }
+  qsort(sorted, len, sizeof(StatsKey), stats_key_cmp);
+  for (i = 0; i < len && i < n; i++) {
+    if (timed)
+      Printf(stdout, "      %-50s %12.0f %12.3f\n", sorted[i].key, (double) sorted[i].calls, sorted[i].time);
+    else
+      Printf(stdout, "      %-50s %12.0f\n", sorted[i].key, (double) sorted[i].calls);
+  }
+  free(sorted);
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_stats_print()
+ *
+ * Display the statistics with the n most expensive keys of each function.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_stats_print(int n) {
+  static const char *doh_names[DOH_STATS_MAX] = { "Getattr", "Setattr", "DohCheck" };
+  int i;
+
+  DohStatsKeys(0);
+  Printf(stdout, "Call statistics:\n");
+  Printf(stdout, "  %-54s %12s %12s\n", "Function / top keys", "Calls", "Time (s)");
+  for (i = 0; i < SWIG_STATS_MAX; i++) {
+    Printf(stdout, "  %-54s %12.0f %12.3f\n", stats_names[i], (double) stats[i].calls, stats[i].time);
+    stats_print_keys(stats_keys[i], 1, n);
+  }
+  for (i = 0; i < DOH_STATS_MAX; i++) {
+    Printf(stdout, "  %-54s %12.0f\n", doh_names[i], (double) DohStatsCalls[i]);
+    stats_print_keys(DohStatsKeyCounts(i), 0, n);
+  }
+  DohStatsKeys(stats_on);
+}
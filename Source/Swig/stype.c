@@ -315,7 +315,11 @@ SwigType *SwigType_default_create(const SwigType *ty) {
   int numitems;
 
   if (!SwigType_isvarargs(ty)) {
-    SwigType *t = SwigType_typedef_resolve_all(ty);
+    SwigType *t;
+    r = SwigType_memo_get(ty, SWIGTYPE_MEMO_DEFAULT);
+    if (r)
+      return Copy(r);
+    t = SwigType_typedef_resolve_all(ty);
     r = NewStringEmpty();
     l = SwigType_split(t);
     numitems = Len(l);
@@ -348,6 +352,7 @@ SwigType *SwigType_default_create(const SwigType *ty) {
 
     Delete(l);
     Delete(t);
+    SwigType_memo_set(ty, SWIGTYPE_MEMO_DEFAULT, r);
   }
 
   return r;
@@ -473,6 +478,10 @@ String *SwigType_namestr(const SwigType *t) {
   if (!c || !strstr(c + 2, ")>"))
     return NewString(t);
 
+  r = SwigType_memo_get(t, SWIGTYPE_MEMO_NAMESTR);
+  if (r)
+    return Copy(r);
+
   r = NewStringWithSize(d, c - d);
   if (*(c - 1) == '<')
     Putc(' ', r);
@@ -502,6 +511,7 @@ String *SwigType_namestr(const SwigType *t) {
   }
   Delete(suffix);
   Delete(p);
+  SwigType_memo_set(t, SWIGTYPE_MEMO_NAMESTR, r);
   return r;
 }
 
@@ -525,6 +535,9 @@ String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
     result = SwigType_str(id_str, 0);
     Delete(id_str);
   } else {
+    result = SwigType_memo_get(s, SWIGTYPE_MEMO_STR);
+    if (result)
+      return Copy(result);
     result = NewStringEmpty();
   }
 
@@ -610,6 +623,8 @@ String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
   }
   Delete(elements);
   Chop(result);
+  if (!id)
+    SwigType_memo_set(s, SWIGTYPE_MEMO_STR, result);
   return result;
 }
 
@@ -721,9 +736,16 @@ String *SwigType_lstr(const SwigType *s, const_String_or_char_ptr id) {
   String *result;
   SwigType *tc;
 
+  if (!id) {
+    result = SwigType_memo_get(s, SWIGTYPE_MEMO_LSTR);
+    if (result)
+      return Copy(result);
+  }
   tc = SwigType_ltype(s);
   result = SwigType_str(tc, id);
   Delete(tc);
+  if (!id)
+    SwigType_memo_set(s, SWIGTYPE_MEMO_LSTR, result);
   return result;
 }
 
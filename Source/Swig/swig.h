@@ -113,6 +113,17 @@ extern "C" {
 
 /* --- Functions for manipulating the string-based type encoding --- */
 
+  /* Results memoized per type by SwigType_memo_get(), the scoped ones depend on typedefs */
+  typedef enum {
+    SWIGTYPE_MEMO_STR,
+    SWIGTYPE_MEMO_NAMESTR,
+    SWIGTYPE_MEMO_BASE,
+    SWIGTYPE_MEMO_SCOPED,
+    SWIGTYPE_MEMO_LSTR = SWIGTYPE_MEMO_SCOPED,
+    SWIGTYPE_MEMO_DEFAULT,
+    SWIGTYPE_MEMO_MAX
+  } SwigTypeMemo;
+
   extern SwigType *NewSwigType(int typecode);
   extern SwigType *SwigType_del_element(SwigType *t);
   extern SwigType *SwigType_add_pointer(SwigType *t);
@@ -163,6 +174,9 @@ extern "C" {
   extern SwigType *SwigType_functionpointer_decompose(SwigType *t);
   extern String *SwigType_base(const SwigType *t);
   extern String *SwigType_namestr(const SwigType *t);
+  extern DOH *SwigType_memo_get(const SwigType *t, SwigTypeMemo which);
+  extern void SwigType_memo_set(const SwigType *t, SwigTypeMemo which, DOH *value);
+  extern void SwigType_memo_flush(void);
   extern String *SwigType_templateprefix(const SwigType *t);
   extern String *SwigType_templatesuffix(const SwigType *t);
   extern String *SwigType_istemplate_templateprefix(const SwigType *t);
@@ -319,6 +333,27 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern String *Swig_string_upper(String *s);
   extern String *Swig_string_title(String *s);
   extern String *Swig_pcre_version(void);
+  extern double Swig_wall_time(void);
+  extern double Swig_cpu_time(void);
+  extern long Swig_peak_memory(void);
+
+/* --- Call statistics (-debug-stats) --- */
+
+  typedef enum {
+    SWIG_STATS_TYPEMAP_SEARCH,
+    SWIG_STATS_SYMBOL_CLOOKUP,
+    SWIG_STATS_TYPEDEF_RESOLVE,
+    SWIG_STATS_FEATURES_GET,
+    SWIG_STATS_NAME_MAKE,
+    SWIG_STATS_OVERLOAD_RANK,
+    SWIG_STATS_TEMPLATE_EXPAND,
+    SWIG_STATS_MAX
+  } SwigStats;
+
+  extern void Swig_stats_set(int flag);
+  extern double Swig_stats_begin(SwigStats which);
+  extern void Swig_stats_end(SwigStats which, double start, const_String_or_char_ptr key, const_String_or_char_ptr subkey);
+  extern void Swig_stats_print(int n);
   extern void Swig_init(void);
   extern int Swig_value_wrapper_mode(int mode);
 
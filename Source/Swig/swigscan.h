@@ -31,6 +31,7 @@ extern String      *Scanner_errmsg(Scanner *);
 extern int          Scanner_errline(Scanner *);
 extern int          Scanner_isoperator(int tokval);
 extern void         Scanner_locator(Scanner *, String *loc);
+extern void         Scanner_debug_throughput(String *text);
 
 /* Note: Tokens in range 100+ are for C/C++ operators */
 
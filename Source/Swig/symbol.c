@@ -177,6 +177,7 @@ static Hash *symtabs = 0;	/* Hash of all symbol tables by fully-qualified name *
 static Hash *global_scope = 0;	/* Global scope */
 
 static int use_inherit = 1;
+static int symbol_epoch = 0;	/* Changed whenever a lookup result may change */
 
 /* common attribute keys, to avoid calling find_key all the times */
 
@@ -292,6 +293,7 @@ void Swig_symbol_init(void) {
 void Swig_symbol_setscopename(const_String_or_char_ptr name) {
   String *qname;
   /* assert(!Getattr(current_symtab,"name")); */
+  symbol_epoch++;
   Setattr(current_symtab, "name", name);
 
   /* Set nested scope in parent */
@@ -432,6 +434,8 @@ Symtab *Swig_symbol_setscope(Symtab *sym) {
 
 Symtab *Swig_symbol_popscope(void) {
   Hash *h = current_symtab;
+  /* The popped scope is about to become the "symtab" of its class or namespace */
+  symbol_epoch++;
   current_symtab = Getattr(current_symtab, "parentNode");
   assert(current_symtab);
   current = Getattr(current_symtab, "symtab");
@@ -476,6 +480,7 @@ void Swig_symbol_alias(const_String_or_char_ptr aliasname, Symtab *s) {
     qname = NewString(aliasname);
   }
   if (!Getattr(symtabs, qname)) {
+    symbol_epoch++;
     Setattr(symtabs, qname, s);
   }
   Delete(qname);
@@ -509,6 +514,7 @@ void Swig_symbol_inherit(Symtab *s) {
     if (n == s)
       return;			/* Already inherited */
   }
+  symbol_epoch++;
   Append(inherit, s);
 }
 
@@ -553,6 +559,7 @@ void Swig_symbol_cadd(const_String_or_char_ptr name, Node *n) {
 #ifdef SWIG_DEBUG
   Printf(stderr, "symbol_cadd %s %p\n", name, n);
 #endif
+  symbol_epoch++;
   cn = Getattr(ccurrent, name);
 
   if (cn && (Getattr(cn, "sym:typename"))) {
@@ -701,6 +708,8 @@ Node *Swig_symbol_add(const_String_or_char_ptr symname, Node *n) {
   int u1 = 0, u2 = 0;
   String *name, *overname;
 
+  symbol_epoch++;
+
   /* See if the node has a name.  If so, we place in the C symbol table for this
      scope. We don't worry about overloading here---the primary purpose of this
      is to record information for type/name resolution for later. Conflicts
@@ -925,13 +934,24 @@ Node *Swig_symbol_add(const_String_or_char_ptr symname, Node *n) {
  * verifying that a class hierarchy implements all pure virtual methods.
  * ----------------------------------------------------------------------------- */
 
-static Node *_symbol_lookup(const String *name, Symtab *symtab, int (*check) (Node *n)) {
+/* The scopes being searched by the enclosing calls, to stop at a cyclic inheritance */
+typedef struct SymbolLookupPath {
+  Symtab *symtab;
+  const struct SymbolLookupPath *prev;
+} SymbolLookupPath;
+
+static Node *_symbol_lookup(const String *name, Symtab *symtab, int (*check) (Node *n), const SymbolLookupPath *path) {
   Node *n;
   List *inherit;
   Hash *sym = Getattr(symtab, "csymtab");
-  if (Getmark(symtab))
-    return 0;
-  Setmark(symtab, 1);
+  const SymbolLookupPath *p;
+  SymbolLookupPath here;
+  for (p = path; p; p = p->prev) {
+    if (p->symtab == symtab)
+      return 0;
+  }
+  here.symtab = symtab;
+  here.prev = path;
 
   n = Getattr(sym, name);
 
@@ -944,31 +964,26 @@ static Node *_symbol_lookup(const String *name, Symtab *symtab, int (*check) (No
     if (check) {
       int c = check(n);
       if (c == 1) {
-	Setmark(symtab, 0);
 	return n;
       }
       if (c < 0) {
 	/* Terminate the search right away */
-	Setmark(symtab, 0);
 	return 0;
       }
     } else {
-      Setmark(symtab, 0);
       return n;
     }
   }
 
   if (!n && SwigType_istemplate(name)) {
     String *dname = 0;
-    Setmark(symtab, 0);
     dname = Swig_symbol_template_deftype(name, symtab);
     if (!Equal(dname, name)) {
-      n = _symbol_lookup(dname, symtab, check);
+      n = _symbol_lookup(dname, symtab, check, path);
     }
     Delete(dname);
     if (n)
       return n;
-    Setmark(symtab, 1);
   }
 
   inherit = Getattr(symtab, "inherit");
@@ -976,25 +991,23 @@ static Node *_symbol_lookup(const String *name, Symtab *symtab, int (*check) (No
     int i, len;
     len = Len(inherit);
     for (i = 0; i < len; i++) {
-      n = _symbol_lookup(name, Getitem(inherit, i), check);
+      n = _symbol_lookup(name, Getitem(inherit, i), check, &here);
       if (n) {
-	Setmark(symtab, 0);
 	return n;
       }
     }
   }
 
-  Setmark(symtab, 0);
   return 0;
 }
 
 static Node *symbol_lookup(const_String_or_char_ptr name, Symtab *symtab, int (*check) (Node *n)) {
   Node *n = 0;
   if (DohCheck(name)) {
-    n = _symbol_lookup(name, symtab, check);
+    n = _symbol_lookup(name, symtab, check, 0);
   } else {
     String *sname = NewString(name);
-    n = _symbol_lookup(sname, symtab, check);
+    n = _symbol_lookup(sname, symtab, check, 0);
     Delete(sname);
   }
   return n;
@@ -1094,9 +1107,52 @@ static Node *symbol_lookup_qualified(const_String_or_char_ptr name, Symtab *symt
  * implemented in symbol_lookup()).
  * ----------------------------------------------------------------------------- */
 
-Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
+/* -----------------------------------------------------------------------------
+ * symbol_clookup_cache()
+ *
+ * The lookup results of each scope for symbol_clookup(), before following any
+ * using declarations.  They are kept in a side table keyed by the address of the
+ * symbol table so that they do not show up in the parse tree.  All results are
+ * discarded when symbol_epoch changes, that is, whenever a symbol, scope,
+ * inherited scope or alias is added or removed, so an address cannot be reused
+ * by another symbol table while it is in the table.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *clookup_caches = 0;	/* symbol table address -> lookup results */
+static int clookup_epoch = 0;
+static String *clookup_key = 0;
+static String *clookup_notfound = 0;
+
+static Hash *symbol_clookup_cache(Symtab *symtab) {
+  Hash *results;
+  if (!clookup_caches) {
+    clookup_caches = NewHash();
+    clookup_key = NewStringEmpty();
+    clookup_notfound = NewStringEmpty();
+    clookup_epoch = symbol_epoch;
+  }
+  if (clookup_epoch != symbol_epoch) {
+    Clear(clookup_caches);
+    clookup_epoch = symbol_epoch;
+  }
+  Clear(clookup_key);
+  Printf(clookup_key, "%p", symtab);
+  results = Getattr(clookup_caches, clookup_key);
+  if (!results) {
+    String *key = Copy(clookup_key);
+    results = NewHash();
+    Setattr(clookup_caches, key, results);
+    Delete(results);
+    Delete(key);
+  }
+  return results;
+}
+
+static Node *symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
   Hash *hsym = 0;
   Node *s = 0;
+  Hash *cache = 0;
+  int epoch = symbol_epoch;
 
   if (!n) {
     hsym = current_symtab;
@@ -1110,35 +1166,53 @@ Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
     }
   }
 
-  if (Swig_scopename_check(name)) {
-    char *cname = Char(name);
-    if (strncmp(cname, "::", 2) == 0) {
-      String *nname = NewString(cname + 2);
-      if (Swig_scopename_check(nname)) {
-	s = symbol_lookup_qualified(nname, global_scope, 0, 0, 0);
+  if (hsym && use_inherit) {
+    cache = symbol_clookup_cache(hsym);
+    s = Getattr(cache, name);
+  }
+
+  if (s) {
+    if (s == clookup_notfound)
+      return 0;
+  } else {
+    Symtab *scope = hsym;
+    if (Swig_scopename_check(name)) {
+      char *cname = Char(name);
+      if (strncmp(cname, "::", 2) == 0) {
+	String *nname = NewString(cname + 2);
+	if (Swig_scopename_check(nname)) {
+	  s = symbol_lookup_qualified(nname, global_scope, 0, 0, 0);
+	} else {
+	  s = symbol_lookup(nname, global_scope, 0);
+	}
+	Delete(nname);
       } else {
-	s = symbol_lookup(nname, global_scope, 0);
-      }
-      Delete(nname);
-    } else {
-      String *prefix = Swig_scopename_prefix(name);
-      if (prefix) {
-	s = symbol_lookup_qualified(name, hsym, 0, 0, 0);
-	Delete(prefix);
-	if (!s) {
-	  return 0;
+	String *prefix = Swig_scopename_prefix(name);
+	if (prefix) {
+	  s = symbol_lookup_qualified(name, scope, 0, 0, 0);
+	  Delete(prefix);
+	  if (!s) {
+	    scope = 0;
+	  }
 	}
       }
     }
-  }
-  if (!s) {
-    while (hsym) {
-      s = symbol_lookup(name, hsym, 0);
-      if (s)
-	break;
-      hsym = Getattr(hsym, "parentNode");
-      if (!hsym)
-	break;
+    if (!s) {
+      while (scope) {
+	s = symbol_lookup(name, scope, 0);
+	if (s)
+	  break;
+	scope = Getattr(scope, "parentNode");
+	if (!scope)
+	  break;
+      }
+    }
+
+    /* Only cache the result if no symbols were added during the lookup */
+    if (cache && epoch == symbol_epoch) {
+      String *key = NewString(name);
+      Setattr(cache, key, s ? s : clookup_notfound);
+      Delete(key);
     }
   }
 
@@ -1158,6 +1232,13 @@ Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
   return s;
 }
 
+Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_SYMBOL_CLOOKUP);
+  Node *s = symbol_clookup(name, n);
+  Swig_stats_end(SWIG_STATS_SYMBOL_CLOOKUP, stats_start, name, 0);
+  return s;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_symbol_clookup_check()
  *
@@ -1372,6 +1453,7 @@ void Swig_symbol_remove(Node *n) {
   Node *symprev;
   Node *symnext;
   Node *fixovername = 0;
+  symbol_epoch++;
   symtab = Getattr(n, "sym:symtab");	/* Get symbol table object */
   symtab = Getattr(symtab, "symtab");	/* Get actual hash table of symbols */
   symname = Getattr(n, "sym:name");
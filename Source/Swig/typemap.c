@@ -707,6 +707,7 @@ ret_result:
  * ----------------------------------------------------------------------------- */
 
 static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_TYPEMAP_SEARCH);
   Hash *result = 0;
   Hash *tm;
   Hash *backup = 0;
@@ -817,6 +818,7 @@ ret_result:
     *matchtype = Copy(ctype);
   Delete(ctype);
   Delete(ctype_unstripped);
+  Swig_stats_end(SWIG_STATS_TYPEMAP_SEARCH, stats_start, tmap_method, type);
   return result;
 }
 
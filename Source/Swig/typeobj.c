@@ -109,6 +109,105 @@ char cvsroot_typeobj_c[] = "$Id$";
  * ----------------------------------------------------------------------------- */
 
 
+/* -----------------------------------------------------------------------------
+ * Type memos
+ *
+ * Results derived from a type encoding by the more expensive string functions,
+ * such as the C string representation, are memoized per distinct encoding so
+ * that they are only computed once.  The string API is unchanged, callers
+ * receive their own copy of a memoized result.  Functions returning lists, such
+ * as SwigType_split(), are not memoized as callers modify the elements and a
+ * deep copy costs as much as splitting again.
+ *
+ * Results that depend on the typedefs in scope are discarded whenever the type
+ * system changes, along with the typedef resolution caches.  The memos are
+ * dropped altogether once TYPE_MEMO_MAX_NODES encodings have been seen, so
+ * memory use stays bounded however many types are processed.
+ * ----------------------------------------------------------------------------- */
+
+#define TYPE_MEMO_MAX_NODES 8192
+
+typedef struct {
+  int epoch;
+  DOH *memo[SWIGTYPE_MEMO_MAX];
+} TypeNode;
+
+static Hash *type_nodes = 0;
+static int scoped_epoch = 0;
+
+static void type_node_clear(int first, int last, TypeNode *node) {
+  int i;
+  for (i = first; i < last; i++) {
+    Delete(node->memo[i]);
+    node->memo[i] = 0;
+  }
+}
+
+static void type_node_delete(void *ptr) {
+  TypeNode *node = (TypeNode *) ptr;
+  type_node_clear(0, SWIGTYPE_MEMO_MAX, node);
+  free(node);
+}
+
+static TypeNode *type_node(const SwigType *t) {
+  DOH *v;
+  String *key;
+  TypeNode *node;
+  if (!type_nodes)
+    type_nodes = NewHash();
+  v = Getattr(type_nodes, t);
+  if (v)
+    return (TypeNode *) Data(v);
+  if (Len(type_nodes) >= TYPE_MEMO_MAX_NODES)
+    Clear(type_nodes);
+  node = (TypeNode *) malloc(sizeof(TypeNode));
+  memset(node, 0, sizeof(TypeNode));
+  node->epoch = scoped_epoch;
+  v = NewVoid(node, type_node_delete);
+  key = NewString(t);
+  Setattr(type_nodes, key, v);
+  Delete(key);
+  Delete(v);
+  return node;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_memo_get()
+ * SwigType_memo_set()
+ *
+ * Look up and store a result computed from type t.  The memos from
+ * SWIGTYPE_MEMO_SCOPED onwards depend on typedefs.
+ * ----------------------------------------------------------------------------- */
+
+DOH *SwigType_memo_get(const SwigType *t, SwigTypeMemo which) {
+  TypeNode *node = type_node(t);
+  if (node->epoch != scoped_epoch) {
+    type_node_clear(SWIGTYPE_MEMO_SCOPED, SWIGTYPE_MEMO_MAX, node);
+    node->epoch = scoped_epoch;
+  }
+  return node->memo[which];
+}
+
+void SwigType_memo_set(const SwigType *t, SwigTypeMemo which, DOH *value) {
+  TypeNode *node = type_node(t);
+  if (node->epoch != scoped_epoch) {
+    type_node_clear(SWIGTYPE_MEMO_SCOPED, SWIGTYPE_MEMO_MAX, node);
+    node->epoch = scoped_epoch;
+  }
+  Delete(node->memo[which]);
+  node->memo[which] = Copy(value);
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_memo_flush()
+ *
+ * Discard the scoped memos, called whenever typedefs or scopes change.
+ * ----------------------------------------------------------------------------- */
+
+void SwigType_memo_flush(void) {
+  scoped_epoch++;
+}
+
 /* -----------------------------------------------------------------------------
  * NewSwigType()
  *
@@ -1011,6 +1110,9 @@ int SwigType_istemplate(const SwigType *t) {
 SwigType *SwigType_base(const SwigType *t) {
   char *c;
   char *lastop = 0;
+  String *result = SwigType_memo_get(t, SWIGTYPE_MEMO_BASE);
+  if (result)
+    return Copy(result);
   c = Char(t);
 
   lastop = c;
@@ -1056,7 +1158,9 @@ SwigType *SwigType_base(const SwigType *t) {
     }
     c++;
   }
-  return NewString(lastop);
+  result = NewString(lastop);
+  SwigType_memo_set(t, SWIGTYPE_MEMO_BASE, result);
+  return result;
 }
 
 /* -----------------------------------------------------------------------------
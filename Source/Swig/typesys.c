@@ -137,6 +137,7 @@ static void flush_cache() {
   typedef_resolve_cache = 0;
   typedef_all_cache = 0;
   typedef_qualified_cache = 0;
+  SwigType_memo_flush();
 }
 
 /* Initialize the scoping system */
@@ -597,7 +598,7 @@ static SwigType *typedef_resolve(Typetab *s, String *base) {
  * ----------------------------------------------------------------------------- */
 
 /* #define SWIG_DEBUG */
-SwigType *SwigType_typedef_resolve(const SwigType *t) {
+static SwigType *typedef_resolve_type(const SwigType *t) {
   String *base;
   String *type = 0;
   String *r = 0;
@@ -817,6 +818,13 @@ return_result:
   return r;
 }
 
+SwigType *SwigType_typedef_resolve(const SwigType *t) {
+  double stats_start = Swig_stats_begin(SWIG_STATS_TYPEDEF_RESOLVE);
+  SwigType *r = typedef_resolve_type(t);
+  Swig_stats_end(SWIG_STATS_TYPEDEF_RESOLVE, stats_start, t, 0);
+  return r;
+}
+
 /* -----------------------------------------------------------------------------
  * SwigType_typedef_resolve_all()
  *
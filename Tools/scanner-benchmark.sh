@@ -0,0 +1,27 @@
+#!/bin/sh
+
+# Measures the throughput of the SWIG scanner over the preprocessed
+# interface files in the test-suite using the -debug-scanner option.
+#
+# Usage: Tools/scanner-benchmark.sh [path-to-swig]
+#
+# Run from the top level directory after building SWIG.
+
+SWIG=${1:-./swig}
+TESTSUITE=Examples/test-suite
+
+if test ! -x "$SWIG"; then
+  echo "$SWIG not found, build SWIG first or pass the path to the swig executable" >&2
+  exit 1
+fi
+
+for i in $TESTSUITE/*.i; do
+  # Only preprocess (-E) each file, the scanner is run over the preprocessed
+  # text before it is output.
+  SWIG_LIB=Lib $SWIG -E -c++ -python -I$TESTSUITE -debug-scanner $i 2>&1 >/dev/null | grep '^Scanner: .* bytes per pass'
+done | awk '
+  { tokens += $2; bytes += $4; secs += $11 / $8 }
+  END {
+    if (secs > 0)
+      printf "%d tokens, %d bytes, %.0f tokens/s, %.2f MB/s\n", tokens, bytes, tokens / secs, bytes / (secs * 1024 * 1024)
+  }'
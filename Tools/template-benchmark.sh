@@ -0,0 +1,38 @@
+#!/bin/sh
+
+# Measures the time and memory taken to instantiate many std::vector
+# templates with %template using the -debug-timing option.  The parse stage
+# includes the template instantiation.
+#
+# Usage: Tools/template-benchmark.sh [path-to-swig] [instantiations] [language]
+#
+# Run from the top level directory after building SWIG.
+
+SWIG=${1:-./swig}
+COUNT=${2:-200}
+LANGUAGE=${3:-python}
+TMPDIR=${TMPDIR:-/tmp}
+WORK=$TMPDIR/swig-template-benchmark.$$
+
+if test ! -x "$SWIG"; then
+  echo "$SWIG not found, build SWIG first or pass the path to the swig executable" >&2
+  exit 1
+fi
+
+mkdir -p $WORK || exit 1
+trap 'rm -rf $WORK' 0
+
+awk -v n=$COUNT 'BEGIN {
+  print "%module template_benchmark"
+  print "%include <std_vector.i>"
+  print "%inline %{"
+  for (i = 0; i < n; i++)
+    printf "struct S%d { int v; };\n", i
+  print "%}"
+  for (i = 0; i < n; i++)
+    printf "%%template(Vec%d) std::vector<S%d>;\n", i, i
+}' > $WORK/template_benchmark.i
+
+SWIG_LIB=Lib $SWIG -$LANGUAGE -c++ -debug-timing -outdir $WORK -o $WORK/template_benchmark_wrap.cxx $WORK/template_benchmark.i | awk -v n=$COUNT '
+  $1 == "parse" { printf "%d instantiations: parse %.3f s, %d objects, peak memory %d KB\n", n, $3, $4, $5 }
+  $1 == "total" { printf "total %.3f s, peak memory %d KB\n", $3, $5 }'